@@ -0,0 +1,471 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// Steady-state churn and random access: the destroy/remove/recycle/flush paths and lookups in
+// an order that does not follow the dense arrays.
+
+namespace
+{
+struct ChurnPosition
+{
+    float x, y;
+};
+
+struct ChurnVelocity
+{
+    float dx, dy;
+};
+
+struct ChurnHealth
+{
+    int hp;
+};
+
+void spawn(acorn::World& world, std::vector<acorn::Entity>& out, size_t i)
+{
+    auto e = world.create_entity();
+    world.add<ChurnPosition>(e, 1.0f, 1.0f);
+    world.add<ChurnHealth>(e, 100);
+    if (i % 2 == 0)
+        world.add<ChurnVelocity>(e, 0.1f, 0.1f);
+    out.push_back(e);
+}
+
+std::vector<acorn::Entity> populate(acorn::World& world, size_t count)
+{
+    std::vector<acorn::Entity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        spawn(world, entities, i);
+    }
+    return entities;
+}
+}  // namespace
+
+// Destroys range(1)% of the live entities at random and spawns the same number again, so
+// the population stays at range(0) while handles, free-list slots and dense positions churn.
+static void BM_Churn_DestroyCreate(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto churn = std::max<size_t>(1, count * static_cast<size_t>(state.range(1)) / 100);
+
+    acorn::World world;
+    auto entities = populate(world, count);
+    std::mt19937 rng{42};
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < churn; ++i)
+        {
+            const size_t slot = rng() % entities.size();
+            world.destroy_entity(entities[slot]);
+            entities[slot] = entities.back();
+            entities.pop_back();
+        }
+        for (size_t i = 0; i < churn; ++i)
+        {
+            spawn(world, entities, i);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(churn));
+}
+
+BENCHMARK(BM_Churn_DestroyCreate)->ArgsProduct({{10000, 100000}, {1, 10}});
+
+// Component-level churn without touching the EntityManager
+static void BM_Churn_PoolRemoveEmplace(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto churn = std::max<size_t>(1, count / 10);
+
+    acorn::World world;
+    auto entities = populate(world, count);
+    auto& pool = world.pool<ChurnHealth>();
+
+    std::mt19937 rng{7};
+    std::shuffle(entities.begin(), entities.end(), rng);
+
+    size_t cursor = 0;
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < churn; ++i)
+        {
+            pool.remove(entities[(cursor + i) % count]);
+        }
+        for (size_t i = 0; i < churn; ++i)
+        {
+            pool.emplace(entities[(cursor + i) % count], 50);
+        }
+        cursor = (cursor + churn) % count;
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(churn));
+}
+
+BENCHMARK(BM_Churn_PoolRemoveEmplace)->Range(1000, 100000);
+
+// Tight destroy/create pairs: every create is served from the free list.
+// range(1) selects the recycle policy: 0 = Lifo, 1 = LowestIndex.
+static void BM_Churn_EntityRecycle(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto policy =
+        state.range(1) == 0 ? acorn::RecyclePolicy::Lifo : acorn::RecyclePolicy::LowestIndex;
+
+    acorn::EntityManager em(0, policy);
+    std::vector<acorn::Entity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        entities.push_back(em.create());
+    }
+
+    std::mt19937 rng{3};
+    std::shuffle(entities.begin(), entities.end(), rng);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (auto& e : entities)
+        {
+            em.destroy(e);
+        }
+        for (auto& e : entities)
+        {
+            e = em.create();
+        }
+        benchmark::DoNotOptimize(entities.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Churn_EntityRecycle)->ArgsProduct({{1000, 100000}, {0, 1}});
+
+static void BM_RandomAccess_Get(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+
+    acorn::World world;
+    auto entities = populate(world, count);
+
+    std::mt19937 rng{11};
+    std::shuffle(entities.begin(), entities.end(), rng);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (auto e : entities)
+        {
+            auto& pos = world.get<ChurnPosition>(e);
+            benchmark::DoNotOptimize(pos);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_RandomAccess_Get)->Range(1000, 1000000);
+
+// Half the handles miss (no velocity), a quarter are stale
+static void BM_RandomAccess_TryGet(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+
+    acorn::World world;
+    auto entities = populate(world, count);
+    for (size_t i = 0; i < count; i += 4)
+    {
+        world.destroy_entity(entities[i]);
+    }
+
+    std::mt19937 rng{13};
+    std::shuffle(entities.begin(), entities.end(), rng);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (auto e : entities)
+        {
+            auto* vel = world.try_get<ChurnVelocity>(e);
+            benchmark::DoNotOptimize(vel);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_RandomAccess_TryGet)->Range(1000, 1000000);
+
+static void BM_Churn_FlushLargeBatch(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+
+    // Each iteration needs a fresh batch; the previous world is torn down while paused
+    std::optional<acorn::World> world;
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        perf.pause_timing();
+        world.emplace();
+        auto entities = populate(*world, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % 2 == 0)
+                world->defer_remove<ChurnHealth>(entities[i]);
+            else
+                world->defer_destroy(entities[i]);
+        }
+        perf.resume_timing();
+
+        world->flush();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Churn_FlushLargeBatch)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// Several rounds of random destroy/respawn leave the Position and Velocity dense arrays in
+// unrelated orders, so every non-lead lookup lands somewhere random.
+static void BM_ViewIteration_Fragmented(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+
+    acorn::World world;
+    auto entities = populate(world, count);
+    std::mt19937 rng{17};
+
+    for (int round = 0; round < 4; ++round)
+    {
+        std::shuffle(entities.begin(), entities.end(), rng);
+        const size_t half = entities.size() / 2;
+        for (size_t i = 0; i < half; ++i)
+        {
+            world.destroy_entity(entities[i]);
+        }
+        entities.erase(entities.begin(), entities.begin() + static_cast<ptrdiff_t>(half));
+        for (size_t i = 0; i < half; ++i)
+        {
+            spawn(world, entities, rng());
+        }
+    }
+
+    auto view = world.view<ChurnPosition, ChurnVelocity>();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each(
+            [](acorn::Entity, ChurnPosition& pos, ChurnVelocity& vel)
+            {
+                pos.x += vel.dx;
+                benchmark::DoNotOptimize(pos);
+            });
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(world.pool<ChurnVelocity>().size()));
+}
+
+BENCHMARK(BM_ViewIteration_Fragmented)->Range(1000, 1000000);
+
+namespace
+{
+template <int N>
+struct ChurnTag
+{
+    int value;
+};
+
+// Registers 30 pools and gives each entity a handful of them, so most pools never see most
+// of a destroy batch
+template <int... Ns>
+void spawn_tagged(acorn::World& world, std::vector<acorn::Entity>& out, size_t count,
+                  std::integer_sequence<int, Ns...>)
+{
+    (world.pool<ChurnTag<Ns>>(), ...);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto e = world.create_entity();
+        ((i % (Ns + 1) == 0 ? (void)world.add<ChurnTag<Ns>>(e, Ns) : void()), ...);
+        out.push_back(e);
+    }
+}
+}  // namespace
+
+// Destroys range(1)% of range(0) entities spread over 30 pools, one at a time (range(2) == 0)
+// or as one destroy_many batch (range(2) == 1)
+static void BM_Churn_DestroyBatch(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto doomed = std::max<size_t>(1, count * static_cast<size_t>(state.range(1)) / 100);
+    const bool batched = state.range(2) != 0;
+
+    std::optional<acorn::World> world;
+    std::vector<acorn::Entity> entities;
+    std::mt19937 rng{17};
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        perf.pause_timing();
+        world.emplace();
+        entities.clear();
+        spawn_tagged(*world, entities, count, std::make_integer_sequence<int, 30>{});
+        std::shuffle(entities.begin(), entities.end(), rng);
+        entities.resize(doomed);
+        perf.resume_timing();
+
+        if (batched)
+        {
+            benchmark::DoNotOptimize(world->destroy_many(entities));
+        }
+        else
+        {
+            for (auto e : entities)
+            {
+                world->destroy_entity(e);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(doomed));
+}
+
+BENCHMARK(BM_Churn_DestroyBatch)
+    ->ArgsProduct({{10000, 100000}, {1, 50}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Level reset: the world once held range(0) entities but only 100 are live when it is cleared
+// and refilled
+static void BM_World_ClearFewLive(benchmark::State& state)
+{
+    const auto high_water = static_cast<size_t>(state.range(0));
+
+    acorn::World world;
+    auto entities = populate(world, high_water);
+    for (size_t i = 100; i < entities.size(); ++i)
+    {
+        world.destroy_entity(entities[i]);
+    }
+    entities.clear();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.clear();
+        for (size_t i = 0; i < 100; ++i)
+        {
+            spawn(world, entities, i);
+        }
+        entities.clear();
+    }
+}
+
+BENCHMARK(BM_World_ClearFewLive)->Range(1000, 1000000);
+
+// The same 100 survivors at the top of the index range instead of the bottom. Under Lifo the
+// refill takes back exactly the slots clear() freed, so they stay on top every iteration.
+static void BM_World_ClearFewLiveHigh(benchmark::State& state)
+{
+    const auto high_water = static_cast<size_t>(state.range(0));
+
+    acorn::World world;
+    auto entities = populate(world, high_water);
+    for (size_t i = 0; i + 100 < entities.size(); ++i)
+    {
+        world.destroy_entity(entities[i]);
+    }
+    entities.clear();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.clear();
+        for (size_t i = 0; i < 100; ++i)
+        {
+            spawn(world, entities, i);
+        }
+        entities.clear();
+    }
+
+    if (world.entity_manager().capacity() != high_water)
+        state.SkipWithError("survivors did not stay on top");
+}
+
+BENCHMARK(BM_World_ClearFewLiveHigh)->Range(1000, 1000000);
+
+// A "destroy whatever died" system over range(0) entities, one in ten of which dies: the
+// deferred two-pass pattern against a single each_safe() pass
+template <bool Safe>
+static void kill_if_dead(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::optional<acorn::World> world;
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        perf.pause_timing();
+        world.emplace();
+        auto entities = populate(*world, count);
+        for (size_t i = 0; i < count; i += 10)
+        {
+            world->get<ChurnHealth>(entities[i]).hp = 0;
+        }
+        perf.resume_timing();
+
+        auto view = world->view<ChurnHealth>();
+        if constexpr (Safe)
+        {
+            view.each_safe(
+                [&](acorn::Entity e, ChurnHealth& h)
+                {
+                    if (h.hp <= 0)
+                        world->destroy_entity(e);
+                });
+        }
+        else
+        {
+            view.each(
+                [&](acorn::Entity e, ChurnHealth& h)
+                {
+                    if (h.hp <= 0)
+                        world->defer_destroy(e);
+                });
+            world->flush();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+static void BM_KillIfDead_Deferred(benchmark::State& state)
+{
+    kill_if_dead<false>(state);
+}
+
+BENCHMARK(BM_KillIfDead_Deferred)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_KillIfDead_EachSafe(benchmark::State& state)
+{
+    kill_if_dead<true>(state);
+}
+
+BENCHMARK(BM_KillIfDead_EachSafe)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// range(0) entities with Position + Velocity. The toggle benchmarks switch a tenth of them off
+// and on again per iteration; the iteration ones run movement with half of them switched off.
+
+namespace
+{
+struct Position
+{
+    float x = 0.0f, y = 0.0f;
+};
+
+struct Velocity
+{
+    float dx = 1.0f, dy = 1.0f;
+};
+
+struct Disabled
+{
+};
+
+std::vector<acorn::Entity> spawn(acorn::World& world, int64_t count)
+{
+    std::vector<acorn::Entity> entities;
+    for (int64_t i = 0; i < count; ++i)
+    {
+        const acorn::Entity e = world.create_entity();
+        world.add<Position>(e);
+        world.add<Velocity>(e);
+        entities.push_back(e);
+    }
+    return entities;
+}
+
+void move(acorn::Entity, Position& p, const Velocity& v)
+{
+    p.x += v.dx;
+    p.y += v.dy;
+}
+}  // namespace
+
+// Switching off by taking Velocity away and giving it back
+static void BM_Enable_ToggleByRemove(benchmark::State& state)
+{
+    acorn::World world;
+    const auto entities = spawn(world, state.range(0));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < entities.size(); i += 10)
+        {
+            world.remove<Velocity>(entities[i]);
+        }
+        for (size_t i = 0; i < entities.size(); i += 10)
+        {
+            world.add<Velocity>(entities[i]);
+        }
+    }
+}
+
+BENCHMARK(BM_Enable_ToggleByRemove)->Range(1000, 100000);
+
+static void BM_Enable_ToggleByDisable(benchmark::State& state)
+{
+    acorn::World world;
+    const auto entities = spawn(world, state.range(0));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < entities.size(); i += 10)
+        {
+            world.disable(entities[i]);
+        }
+        for (size_t i = 0; i < entities.size(); i += 10)
+        {
+            world.enable(entities[i]);
+        }
+    }
+}
+
+BENCHMARK(BM_Enable_ToggleByDisable)->Range(1000, 100000);
+
+static void BM_Enable_IterateTagged(benchmark::State& state)
+{
+    acorn::World world;
+    const auto entities = spawn(world, state.range(0));
+    for (size_t i = 0; i < entities.size(); i += 2)
+    {
+        world.add<Disabled>(entities[i]);
+    }
+
+    auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<Disabled>{});
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each(move);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Enable_IterateTagged)->Range(1000, 100000);
+
+static void BM_Enable_IterateDisabled(benchmark::State& state)
+{
+    acorn::World world;
+    const auto entities = spawn(world, state.range(0));
+    for (size_t i = 0; i < entities.size(); i += 2)
+    {
+        world.disable(entities[i]);
+    }
+
+    auto view = world.view<Position, Velocity>();
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each(move);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Enable_IterateDisabled)->Range(1000, 100000);
+
+// Nothing disabled: the check must cost nothing per entity
+static void BM_Enable_IterateNoneDisabled(benchmark::State& state)
+{
+    acorn::World world;
+    spawn(world, state.range(0));
+
+    auto view = world.view<Position, Velocity>();
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each(move);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Enable_IterateNoneDisabled)->Range(1000, 100000);
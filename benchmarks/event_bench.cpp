@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <thread>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// One tick of event traffic: range(0) damage events produced, then consumed by one system
+
+namespace
+{
+struct DamageEvent
+{
+    uint32_t target;
+    float amount;
+};
+}  // namespace
+
+// The old pattern: every event is a short-lived entity carrying an event component
+static void BM_Events_AsEntities(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    acorn::World world;
+    std::vector<acorn::Entity> spawned;
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto e = world.create_entity();
+            world.add<DamageEvent>(e, static_cast<uint32_t>(i), 1.0f);
+            spawned.push_back(e);
+        }
+
+        float total = 0.0f;
+        world.view<DamageEvent>().each([&](acorn::Entity, const DamageEvent& d)
+                                       { total += d.amount; });
+        benchmark::DoNotOptimize(total);
+
+        world.destroy_many(spawned);
+        spawned.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Events_AsEntities)->Range(1000, 100000);
+
+static void BM_Events_Channel(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    acorn::World world;
+    auto& channel = world.events<DamageEvent>();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            channel.send(DamageEvent{static_cast<uint32_t>(i), 1.0f});
+        }
+        world.swap_events();
+
+        float total = 0.0f;
+        for (const auto& d : channel.read())
+        {
+            total += d.amount;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Events_Channel)->Range(1000, 100000);
+
+// range(1) threads each sending their share through the lock-free path
+static void BM_Events_ChannelConcurrent(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto threads = static_cast<size_t>(state.range(1));
+    acorn::World world;
+    auto& channel = world.events<DamageEvent>();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        std::vector<std::thread> producers;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            producers.emplace_back(
+                [&, t]
+                {
+                    for (size_t i = t; i < count; i += threads)
+                    {
+                        channel.send_concurrent(DamageEvent{static_cast<uint32_t>(i), 1.0f});
+                    }
+                });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        world.swap_events();
+        benchmark::DoNotOptimize(channel.read().size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Events_ChannelConcurrent)
+    ->ArgsProduct({{100000}, {1, 4}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
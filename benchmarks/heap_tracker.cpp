@@ -0,0 +1,126 @@
+#include "heap_tracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+
+namespace
+{
+std::atomic<int64_t> g_in_use{0};
+std::atomic<int64_t> g_peak{0};
+
+#if defined(__GLIBC__)
+void* tracked_alloc(std::size_t n, std::size_t alignment = 0)
+{
+    // glibc's aligned_alloc takes any size; malloc_usable_size works on its blocks too
+    void* p = alignment ? std::aligned_alloc(alignment, n ? n : 1) : std::malloc(n ? n : 1);
+    if (!p)
+        throw std::bad_alloc{};
+
+    const auto size = static_cast<int64_t>(malloc_usable_size(p));
+    const int64_t now = g_in_use.fetch_add(size, std::memory_order_relaxed) + size;
+
+    int64_t peak = g_peak.load(std::memory_order_relaxed);
+    while (now > peak && !g_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed))
+    {
+    }
+    return p;
+}
+
+void tracked_free(void* p) noexcept
+{
+    if (!p)
+        return;
+
+    g_in_use.fetch_sub(static_cast<int64_t>(malloc_usable_size(p)), std::memory_order_relaxed);
+    std::free(p);
+}
+#endif
+}  // namespace
+
+namespace acorn_bench
+{
+int64_t heap_in_use() noexcept
+{
+    return g_in_use.load(std::memory_order_relaxed);
+}
+
+int64_t heap_peak() noexcept
+{
+    return g_peak.load(std::memory_order_relaxed);
+}
+
+void reset_heap_peak() noexcept
+{
+    g_peak.store(g_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+}  // namespace acorn_bench
+
+#if defined(__GLIBC__)
+// Only linked into the heap benchmark binary: every allocation pays two relaxed atomic RMWs.
+// The nothrow overloads forward to these; the aligned ones are replaced as well so buffers
+// such as RuntimePool's are counted.
+void* operator new(std::size_t n)
+{
+    return tracked_alloc(n);
+}
+
+void* operator new[](std::size_t n)
+{
+    return tracked_alloc(n);
+}
+
+void* operator new(std::size_t n, std::align_val_t alignment)
+{
+    return tracked_alloc(n, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t n, std::align_val_t alignment)
+{
+    return tracked_alloc(n, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    tracked_free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    tracked_free(p);
+}
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// Heap accounting for the benchmarks built into acorn_heap_bench, the only binary that links
+// heap_tracker.cpp and with it the replaced global operator new/delete
+
+namespace acorn_bench
+{
+// Bytes currently allocated through global operator new. Always 0 when the platform offers no
+// way to size a block on free (tracking is implemented for glibc only).
+int64_t heap_in_use() noexcept;
+
+// Highest value heap_in_use() reached since the last reset_heap_peak().
+int64_t heap_peak() noexcept;
+
+void reset_heap_peak() noexcept;
+}  // namespace acorn_bench
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// range(0) NPCs of which one in ten is active. Each iteration runs a movement system over the
+// active ones.
+
+namespace
+{
+struct Position
+{
+    float x = 0.0f, y = 0.0f;
+};
+
+struct Velocity
+{
+    float dx = 1.0f, dy = 1.0f;
+};
+
+struct Brain
+{
+    std::array<float, 30> weights{};
+};
+
+struct Idle
+{
+};
+
+std::vector<acorn::Entity> spawn_npcs(acorn::World& world, int64_t count)
+{
+    std::vector<acorn::Entity> idle;
+    for (int64_t i = 0; i < count; ++i)
+    {
+        const acorn::Entity e = world.create_entity();
+        world.add<Position>(e);
+        world.add<Velocity>(e);
+        world.add<Brain>(e);
+        if (i % 10 != 0)
+            idle.push_back(e);
+    }
+    return idle;
+}
+}  // namespace
+
+// Idle NPCs stay in the hot pools behind a tag every system excludes
+static void BM_Hibernate_IdleTag(benchmark::State& state)
+{
+    acorn::World world;
+    for (const acorn::Entity e : spawn_npcs(world, state.range(0)))
+    {
+        world.add<Idle>(e);
+    }
+
+    auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<Idle>{});
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each(
+            [](acorn::Entity, Position& p, const Velocity& v)
+            {
+                p.x += v.dx;
+                p.y += v.dy;
+            });
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Hibernate_IdleTag)->Range(1000, 100000);
+
+static void BM_Hibernate_Hibernated(benchmark::State& state)
+{
+    acorn::World world;
+    world.hibernate_many(spawn_npcs(world, state.range(0)));
+
+    auto view = world.view<Position, Velocity>();
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each(
+            [](acorn::Entity, Position& p, const Velocity& v)
+            {
+                p.x += v.dx;
+                p.y += v.dy;
+            });
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Hibernate_Hibernated)->Range(1000, 100000);
+
+// Cost of parking and restoring 1% of the idle NPCs, per entity
+static void BM_Hibernate_WakeAndSleep(benchmark::State& state)
+{
+    acorn::World world;
+    const auto idle = spawn_npcs(world, state.range(0));
+    world.hibernate_many(idle);
+
+    const std::span<const acorn::Entity> batch(idle.data(), idle.size() / 100);
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.wake_many(batch);
+        world.hibernate_many(batch);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch.size()));
+}
+
+BENCHMARK(BM_Hibernate_WakeAndSleep)->Range(1000, 100000);
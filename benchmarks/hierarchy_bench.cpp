@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "hierarchy.hpp"
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// Transform propagation over a random forest, with parents created after some of their children
+
+namespace
+{
+struct LocalOffset
+{
+    float x, y, z;
+};
+
+struct WorldOffset
+{
+    float x, y, z;
+};
+
+struct Scene
+{
+    acorn::World world;
+    acorn::Hierarchy& hierarchy{world.hierarchy()};
+};
+
+void build(Scene& scene, size_t count)
+{
+    std::mt19937 rng{5};
+    std::vector<acorn::Entity> entities;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto e = scene.world.create_entity();
+        scene.world.add<LocalOffset>(e, 1.0f, 0.5f, 0.25f);
+        scene.world.add<WorldOffset>(e, 0.0f, 0.0f, 0.0f);
+        entities.push_back(e);
+    }
+
+    // Node i hangs off a random earlier node of a shuffled order, one in 64 is a root, so the
+    // pools' creation order does not follow the tree
+    std::vector<acorn::Entity> order = entities;
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const acorn::Entity parent = i % 64 == 0 ? acorn::Entity::null() : order[rng() % i];
+        scene.hierarchy.attach(order[i], parent);
+    }
+    scene.hierarchy.sort();
+}
+}  // namespace
+
+// Baseline: the parents-first order of each(), with every component, the parent's included,
+// found through its pool's sparse array
+static void BM_Hierarchy_PropagateByLookup(benchmark::State& state)
+{
+    Scene scene;
+    build(scene, static_cast<size_t>(state.range(0)));
+    auto& locals = scene.world.pool<LocalOffset>();
+    auto& outs = scene.world.pool<WorldOffset>();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        scene.hierarchy.each(
+            [&](acorn::Entity e, acorn::Entity parent)
+            {
+                const auto& local = locals.get(e);
+                auto& out = outs.get(e);
+                out = {local.x, local.y, local.z};
+                if (!parent.is_null())
+                {
+                    const auto& up = outs.get(parent);
+                    out.x += up.x;
+                    out.y += up.y;
+                    out.z += up.z;
+                }
+            });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Hierarchy_PropagateByLookup)->Range(1000, 100000);
+
+// The same pass once both pools follow Hierarchy::order(): position i of each pool is entity i
+// of the order, and the parent is read at its position, so no sparse lookups remain
+static void BM_Hierarchy_PropagateSorted(benchmark::State& state)
+{
+    Scene scene;
+    build(scene, static_cast<size_t>(state.range(0)));
+    auto& locals = scene.world.pool<LocalOffset>();
+    auto& outs = scene.world.pool<WorldOffset>();
+    locals.sort_as(scene.hierarchy.order());
+    outs.sort_as(scene.hierarchy.order());
+    const auto parents = scene.hierarchy.parent_positions();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        outs.mark_modified();
+        for (uint32_t i = 0; i < parents.size(); ++i)
+        {
+            const auto& local = locals.data_at(i);
+            auto& out = outs.data_at(i);
+            out = {local.x, local.y, local.z};
+            if (parents[i] != acorn::Hierarchy::kNoParent)
+            {
+                const auto& up = outs.data_at(parents[i]);
+                out.x += up.x;
+                out.y += up.y;
+                out.z += up.z;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Hierarchy_PropagateSorted)->Range(1000, 100000);
+
+// What lining the pools up costs after the tree changed: sort() plus sort_as() on two pools
+static void BM_Hierarchy_SortAndArrange(benchmark::State& state)
+{
+    Scene scene;
+    build(scene, static_cast<size_t>(state.range(0)));
+    auto& locals = scene.world.pool<LocalOffset>();
+    auto& outs = scene.world.pool<WorldOffset>();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        scene.hierarchy.sort();
+        locals.sort_as(scene.hierarchy.order());
+        outs.sort_as(scene.hierarchy.order());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Hierarchy_SortAndArrange)->Range(1000, 100000);
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// Looking entities up by a component field: a view scan against a hash index
+
+namespace
+{
+struct NetworkId
+{
+    uint32_t id;
+};
+
+acorn::World& populate(acorn::World& world, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        world.add<NetworkId>(world.create_entity(), static_cast<uint32_t>(i * 7919));
+    }
+    return world;
+}
+}  // namespace
+
+static void BM_Index_FindByScan(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    acorn::World world;
+    populate(world, count);
+    std::mt19937 rng{3};
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        const uint32_t wanted = static_cast<uint32_t>(rng() % count) * 7919;
+        acorn::Entity found = acorn::Entity::null();
+        world.view<NetworkId>().each(
+            [&](acorn::Entity e, const NetworkId& n)
+            {
+                if (n.id == wanted)
+                    found = e;
+            });
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK(BM_Index_FindByScan)->Range(1000, 100000);
+
+static void BM_Index_FindByHash(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    acorn::World world;
+    populate(world, count);
+    auto& by_id = world.pool<NetworkId>().add_hash_index(&NetworkId::id);
+    std::mt19937 rng{3};
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        const uint32_t wanted = static_cast<uint32_t>(rng() % count) * 7919;
+        benchmark::DoNotOptimize(by_id.find_one(wanted));
+    }
+}
+
+BENCHMARK(BM_Index_FindByHash)->Range(1000, 100000);
+
+// What keeping the index costs on the write path
+static void BM_Index_EmplaceRemove(benchmark::State& state)
+{
+    const bool indexed = state.range(0) != 0;
+    acorn::World world;
+    populate(world, 10000);
+    if (indexed)
+        world.pool<NetworkId>().add_hash_index(&NetworkId::id);
+
+    auto e = world.create_entity();
+    uint32_t next = 1;
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.add<NetworkId>(e, next++);
+        world.remove<NetworkId>(e);
+    }
+}
+
+BENCHMARK(BM_Index_EmplaceRemove)->Arg(0)->Arg(1);
@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include "perf_counters.hpp"
 #include "world.hpp"
 
 struct Position
@@ -12,9 +13,14 @@ struct Velocity
     float dx, dy;
 };
 
+// 10M-entity runs take minutes, so they are registered apart under a "_Huge" name. Skip them
+// with --benchmark_filter=-_Huge.
+constexpr int64_t kHugeEntities = 10000000;
+
 static void BM_EntityCreation(benchmark::State& state)
 {
     acorn::World world;
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto e = world.create_entity();
@@ -28,6 +34,7 @@ static void BM_ComponentAdd(benchmark::State& state)
 {
     acorn::World world;
     auto e = world.create_entity();
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         world.add<Position>(e, 1.0f, 2.0f);
@@ -54,6 +61,7 @@ static void BM_ViewIteration(benchmark::State& state)
 
     auto view = world.view<Position, Velocity>();
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         view.each(
@@ -66,7 +74,46 @@ static void BM_ViewIteration(benchmark::State& state)
     state.SetItemsProcessed(state.iterations() * (entity_count / 2));
 }
 
-BENCHMARK(BM_ViewIteration)->Range(1000, 10000);
+BENCHMARK(BM_ViewIteration)->Range(1000, 10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_ViewIteration)->Name("BM_ViewIteration_Huge")->Arg(kHugeEntities);
+
+// range(1) is the lookahead distance handed to each_prefetched
+static void BM_ViewIteration_Prefetched(benchmark::State& state)
+{
+    acorn::World world;
+    const size_t entity_count = state.range(0);
+
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, 1.0f, 1.0f);
+        if (i % 2 == 0)
+        {
+            world.add<Velocity>(e, 0.1f, 0.1f);
+        }
+    }
+
+    auto view = world.view<Position, Velocity>();
+    const auto lookahead = static_cast<size_t>(state.range(1));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each_prefetched(
+            [](acorn::Entity, Position& pos, Velocity& vel)
+            {
+                pos.x += vel.dx;
+                benchmark::DoNotOptimize(pos);
+            },
+            lookahead);
+    }
+    state.SetItemsProcessed(state.iterations() * (entity_count / 2));
+}
+
+BENCHMARK(BM_ViewIteration_Prefetched)->ArgsProduct({{100000, 1000000}, {4, 16, 64}});
+BENCHMARK(BM_ViewIteration_Prefetched)
+    ->Name("BM_ViewIteration_Prefetched_Huge")
+    ->ArgsProduct({{kHugeEntities}, {4, 16, 64}});
 
 static void BM_ViewIteration_SparseMatch(benchmark::State& state)
 {
@@ -84,6 +131,7 @@ static void BM_ViewIteration_SparseMatch(benchmark::State& state)
         }
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view<Position, Velocity>();
@@ -94,7 +142,175 @@ static void BM_ViewIteration_SparseMatch(benchmark::State& state)
     }
 }
 
-BENCHMARK(BM_ViewIteration_SparseMatch)->Range(1000, 10000);
+BENCHMARK(BM_ViewIteration_SparseMatch)->Range(1000, 10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_ViewIteration_SparseMatch)
+    ->Name("BM_ViewIteration_SparseMatch_Huge")
+    ->Arg(kHugeEntities);
+
+static void BM_ViewIteration_SparseMatch_Prefetched(benchmark::State& state)
+{
+    acorn::World world;
+    const size_t entity_count = state.range(0);
+
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, 1.0f, 1.0f);
+
+        if (i % 100 == 0)
+        {
+            world.add<Velocity>(e, 0.1f, 0.1f);
+        }
+    }
+
+    const auto lookahead = static_cast<size_t>(state.range(1));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto view = world.view<Position, Velocity>();
+        view.each_prefetched([](acorn::Entity, Position& pos, Velocity&)
+                             { benchmark::DoNotOptimize(pos); },
+                             lookahead);
+    }
+}
+
+BENCHMARK(BM_ViewIteration_SparseMatch_Prefetched)->ArgsProduct({{100000, 1000000}, {4, 16, 64}});
+BENCHMARK(BM_ViewIteration_SparseMatch_Prefetched)
+    ->Name("BM_ViewIteration_SparseMatch_Prefetched_Huge")
+    ->ArgsProduct({{kHugeEntities}, {4, 16, 64}});
+
+static void BM_ViewIteration_SparseMatch_Batched(benchmark::State& state)
+{
+    acorn::World world;
+    const size_t entity_count = state.range(0);
+
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, 1.0f, 1.0f);
+
+        if (i % 100 == 0)
+        {
+            world.add<Velocity>(e, 0.1f, 0.1f);
+        }
+    }
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto view = world.view<Position, Velocity>();
+        view.each_batched([](acorn::Entity, Position& pos, Velocity&)
+                          { benchmark::DoNotOptimize(pos); });
+    }
+}
+
+BENCHMARK(BM_ViewIteration_SparseMatch_Batched)->Range(1000, 10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_ViewIteration_SparseMatch_Batched)
+    ->Name("BM_ViewIteration_SparseMatch_Batched_Huge")
+    ->Arg(kHugeEntities);
+
+// Both components on a random third of the entities, so the lead misses its partner about
+// two times out of three in no predictable pattern
+static void setup_random_overlap(acorn::World& world, size_t entity_count)
+{
+    uint32_t seed = 12345;
+    auto next = [&] { return seed = seed * 1664525u + 1013904223u; };
+
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto e = world.create_entity();
+        if ((next() >> 8) % 3 == 0)
+            world.add<Position>(e, 1.0f, 1.0f);
+        if ((next() >> 8) % 3 == 0)
+            world.add<Velocity>(e, 0.1f, 0.1f);
+    }
+}
+
+static void BM_ViewIteration_RandomOverlap(benchmark::State& state)
+{
+    acorn::World world;
+    setup_random_overlap(world, state.range(0));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.view<Position, Velocity>().each([](acorn::Entity, Position& pos, Velocity&)
+                                              { benchmark::DoNotOptimize(pos); });
+    }
+}
+
+BENCHMARK(BM_ViewIteration_RandomOverlap)->Range(1000, 10000)->Arg(100000)->Arg(1000000);
+
+static void BM_ViewIteration_RandomOverlap_Batched(benchmark::State& state)
+{
+    acorn::World world;
+    setup_random_overlap(world, state.range(0));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.view<Position, Velocity>().each_batched([](acorn::Entity, Position& pos, Velocity&)
+                                                      { benchmark::DoNotOptimize(pos); });
+    }
+}
+
+BENCHMARK(BM_ViewIteration_RandomOverlap_Batched)
+    ->Range(1000, 10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+static void BM_ViewIteration_SparseMatch_Present(benchmark::State& state)
+{
+    acorn::World world;
+    world.pool<Position>().track_presence();
+    world.pool<Velocity>().track_presence();
+    const size_t entity_count = state.range(0);
+
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, 1.0f, 1.0f);
+
+        if (i % 100 == 0)
+        {
+            world.add<Velocity>(e, 0.1f, 0.1f);
+        }
+    }
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto view = world.view<Position, Velocity>();
+        view.each_present([](acorn::Entity, Position& pos, Velocity&)
+                          { benchmark::DoNotOptimize(pos); });
+    }
+}
+
+BENCHMARK(BM_ViewIteration_SparseMatch_Present)->Range(1000, 10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_ViewIteration_SparseMatch_Present)
+    ->Name("BM_ViewIteration_SparseMatch_Present_Huge")
+    ->Arg(kHugeEntities);
+
+static void BM_ViewIteration_RandomOverlap_Present(benchmark::State& state)
+{
+    acorn::World world;
+    world.pool<Position>().track_presence();
+    world.pool<Velocity>().track_presence();
+    setup_random_overlap(world, state.range(0));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.view<Position, Velocity>().each_present([](acorn::Entity, Position& pos, Velocity&)
+                                                      { benchmark::DoNotOptimize(pos); });
+    }
+}
+
+BENCHMARK(BM_ViewIteration_RandomOverlap_Present)
+    ->Range(1000, 10000)
+    ->Arg(100000)
+    ->Arg(1000000);
 
 static void BM_ViewIteration_SingleComponent(benchmark::State& state)
 {
@@ -106,6 +322,7 @@ static void BM_ViewIteration_SingleComponent(benchmark::State& state)
         world.add<Position>(e, 1.0f, 1.0f);
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view<Position>();
@@ -139,6 +356,7 @@ static void BM_ViewIteration_NoExclude(benchmark::State& state)
         world.add<Velocity>(e, 0.1f, 0.1f);
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view<Position, Velocity>();
@@ -168,6 +386,7 @@ static void BM_ExcludeView_NoneExcluded(benchmark::State& state)
         // no PlayerTag on anything — exclude pool is empty
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<PlayerTag>{});
@@ -198,6 +417,7 @@ static void BM_ExcludeView_HalfExcluded(benchmark::State& state)
             world.add<PlayerTag>(e);
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<PlayerTag>{});
@@ -210,6 +430,36 @@ static void BM_ExcludeView_HalfExcluded(benchmark::State& state)
 
 BENCHMARK(BM_ExcludeView_HalfExcluded)->Range(1000, 100000);
 
+static void BM_ExcludeView_HalfExcluded_Present(benchmark::State& state)
+{
+    acorn::World world;
+    world.pool<Position>().track_presence();
+    world.pool<Velocity>().track_presence();
+    world.pool<PlayerTag>().track_presence();
+    const size_t count = state.range(0);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, 1.f, 1.f);
+        world.add<Velocity>(e, 0.1f, 0.1f);
+        if (i % 2 == 0)
+            world.add<PlayerTag>(e);
+    }
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<PlayerTag>{});
+        view.each_present([](acorn::Entity, Position& pos, Velocity&)
+                          { benchmark::DoNotOptimize(pos); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * (count / 2));
+}
+
+BENCHMARK(BM_ExcludeView_HalfExcluded_Present)->Range(1000, 100000);
+
 static void BM_ExcludeView_OneExcluded(benchmark::State& state)
 {
     acorn::World world;
@@ -229,6 +479,7 @@ static void BM_ExcludeView_OneExcluded(benchmark::State& state)
         world.add<Velocity>(e, 0.1f, 0.1f);
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<PlayerTag>{});
@@ -261,6 +512,7 @@ static void BM_ExcludeView_MultipleExcludeTags(benchmark::State& state)
             world.add<FrozenTag>(e);
     }
 
+    acorn_bench::PerfCounters perf{state};
     for (auto _ : state)
     {
         auto view = world.view_exclude<Position, Velocity>(acorn::Exclude<PlayerTag, FrozenTag>{});
@@ -271,4 +523,4 @@ static void BM_ExcludeView_MultipleExcludeTags(benchmark::State& state)
 
 BENCHMARK(BM_ExcludeView_MultipleExcludeTags)->Range(1000, 100000);
 
-BENCHMARK_MAIN();
\ No newline at end of file
+BENCHMARK_MAIN();
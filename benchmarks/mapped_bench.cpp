@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "component_pool.hpp"
+#include "mapped_vector.hpp"
+#include "perf_counters.hpp"
+#include "view.hpp"
+
+// Iterating a file-backed pool through the page cache against an in-memory one. range(1)
+// selects the storage: 0 for std::vector, 1 for MappedStorage under the temp directory.
+
+namespace
+{
+struct Sample
+{
+    float value[4];
+};
+
+template <typename Pool>
+void iterate(benchmark::State& state, Pool& pool, acorn::EntityManager& em, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pool.emplace(em.create(), Sample{{1.0f, 2.0f, 3.0f, 4.0f}});
+    }
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        float total = 0.0f;
+        acorn::View<Pool>(pool).each([&](acorn::Entity, const Sample& s) { total += s.value[0]; });
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(count * sizeof(Sample)));
+}
+}  // namespace
+
+static void BM_MappedPool_ViewIteration(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    acorn::EntityManager em;
+
+    if (state.range(1) == 0)
+    {
+        acorn::ComponentPool<Sample> pool(em);
+        iterate(state, pool, em, count);
+        return;
+    }
+
+    const auto dir = std::filesystem::temp_directory_path() / "acorn_mapped_bench";
+    std::filesystem::remove_all(dir);
+    {
+        acorn::ComponentPool<Sample, acorn::DefaultEntityTraits, acorn::MappedStorage> pool(
+            em, acorn::MappedStorage(dir));
+        iterate(state, pool, em, count);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+BENCHMARK(BM_MappedPool_ViewIteration)
+    ->ArgsProduct({{100000, 1000000}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "partition.hpp"
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// An open world of 100 cells with only range(0) of them active
+
+namespace
+{
+struct CellPosition
+{
+    float x, y;
+};
+
+struct CellVelocity
+{
+    float dx, dy;
+};
+
+void populate(acorn::World& world, acorn::Partition& partition, size_t per_cell, size_t active)
+{
+    for (acorn::CellId cell = 0; cell < 100; ++cell)
+    {
+        for (size_t i = 0; i < per_cell; ++i)
+        {
+            auto e = world.create_entity();
+            world.add<CellPosition>(e, 0.0f, 0.0f);
+            world.add<CellVelocity>(e, 1.0f, 1.0f);
+            partition.assign(e, cell);
+        }
+        partition.set_active(cell, cell < active);
+    }
+}
+}  // namespace
+
+static void BM_Partition_ViewFiltered(benchmark::State& state)
+{
+    acorn::World world;
+    acorn::Partition partition(world);
+    populate(world, partition, 1000, static_cast<size_t>(state.range(0)));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.view<CellPosition, CellVelocity>().each_where(
+            [&](acorn::Entity e) { return partition.is_active(e); },
+            [](acorn::Entity, CellPosition& p, const CellVelocity& v)
+            {
+                p.x += v.dx;
+                p.y += v.dy;
+            });
+    }
+}
+
+BENCHMARK(BM_Partition_ViewFiltered)->Arg(5)->Arg(50);
+
+static void BM_Partition_EachActive(benchmark::State& state)
+{
+    acorn::World world;
+    acorn::Partition partition(world);
+    populate(world, partition, 1000, static_cast<size_t>(state.range(0)));
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        partition.each_active<CellPosition, CellVelocity>(
+            [](acorn::Entity, CellPosition& p, const CellVelocity& v)
+            {
+                p.x += v.dx;
+                p.y += v.dy;
+            });
+    }
+}
+
+BENCHMARK(BM_Partition_EachActive)->Arg(5)->Arg(50);
+
+// Unloading one cell and loading it back from its blob, against range(0) entities per cell
+static void BM_Partition_CellRoundTrip(benchmark::State& state)
+{
+    const auto per_cell = static_cast<size_t>(state.range(0));
+    acorn::World world;
+    acorn::Partition partition(world);
+    partition.register_component<CellPosition>("position");
+    partition.register_component<CellVelocity>("velocity");
+    populate(world, partition, per_cell, 100);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto blob = partition.save(42);
+        partition.unload(42);
+        benchmark::DoNotOptimize(partition.load(42, blob));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(per_cell));
+}
+
+BENCHMARK(BM_Partition_CellRoundTrip)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,146 @@
+#pragma once
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace acorn_bench
+{
+// Hardware counters around a benchmark's timed loop, reported as per-iteration user counters.
+// Construct it right before `for (auto _ : state)`; the destructor stops the counters and
+// attaches them to the state. Benchmarks that pause the timer go through pause_timing() and
+// resume_timing() so the untimed setup is not counted either. Events the kernel refuses to
+// open (perf_event_paranoid, seccomp, missing PMU in a VM, non-Linux hosts) are simply left
+// out of the report.
+class PerfCounters
+{
+public:
+    explicit PerfCounters(benchmark::State& state) : state_(state)
+    {
+#if defined(__linux__)
+        for (size_t i = 0; i < kEvents.size(); ++i)
+        {
+            fds_[i] = open_event(kEvents[i].config);
+        }
+        for (int fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // state.PauseTiming() that also stops the counters
+    void pause_timing()
+    {
+        state_.PauseTiming();
+        set_enabled(false);
+    }
+
+    void resume_timing()
+    {
+        set_enabled(true);
+        state_.ResumeTiming();
+    }
+
+    ~PerfCounters()
+    {
+#if defined(__linux__)
+        set_enabled(false);
+
+        for (size_t i = 0; i < kEvents.size(); ++i)
+        {
+            if (fds_[i] < 0)
+                continue;
+
+            double value = 0.0;
+            if (read_scaled(fds_[i], value) && state_.iterations() > 0)
+            {
+                state_.counters[kEvents[i].name] =
+                    benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+            }
+            close(fds_[i]);
+        }
+#endif
+    }
+
+private:
+    void set_enabled(bool enabled) noexcept
+    {
+#if defined(__linux__)
+        for (int fd : fds_)
+        {
+            if (fd >= 0)
+                ioctl(fd, enabled ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+        }
+#else
+        (void)enabled;
+#endif
+    }
+
+    benchmark::State& state_;
+
+#if defined(__linux__)
+    struct Event
+    {
+        const char* name;
+        uint64_t config;
+    };
+
+    static constexpr std::array<Event, 3> kEvents{{
+        {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+        {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+        {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    static int open_event(uint64_t config) noexcept
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // pid = 0, cpu = -1: this thread, on whichever CPU it runs
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    // The PMU has few slots, so the kernel may multiplex events; scale the raw count by
+    // enabled/running time to estimate what a dedicated counter would have seen.
+    static bool read_scaled(int fd, double& out) noexcept
+    {
+        uint64_t buf[3]{};
+        if (read(fd, buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)))
+            return false;
+
+        const uint64_t raw = buf[0];
+        const uint64_t enabled = buf[1];
+        const uint64_t running = buf[2];
+        if (running == 0)
+            return false;
+
+        out = static_cast<double>(raw) * static_cast<double>(enabled) /
+              static_cast<double>(running);
+        return true;
+    }
+
+    std::array<int, kEvents.size()> fds_{};
+#endif
+};
+}  // namespace acorn_bench
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+namespace
+{
+struct GameClock
+{
+    float dt;
+};
+
+struct Transform
+{
+    float x, y;
+};
+
+struct Motion
+{
+    float dx, dy;
+};
+}  // namespace
+
+// Global state read the old way: a component on a dummy entity, next to a real resource
+static void BM_Resource_AsComponent(benchmark::State& state)
+{
+    acorn::World world;
+    world.pool<Transform>();
+    world.pool<Motion>();
+    auto holder = world.create_entity();
+    world.add<GameClock>(holder, 0.016f);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(world.get<GameClock>(holder).dt);
+    }
+}
+
+BENCHMARK(BM_Resource_AsComponent);
+
+static void BM_Resource_Direct(benchmark::State& state)
+{
+    acorn::World world;
+    world.set_resource<GameClock>(0.016f);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(world.resource<GameClock>().dt);
+    }
+}
+
+BENCHMARK(BM_Resource_Direct);
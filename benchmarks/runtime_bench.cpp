@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// A script-defined component { float current; float max; } on range(0) entities, with every
+// current value decremented once per iteration
+
+namespace
+{
+acorn::ComponentLayout health_layout()
+{
+    return {.name = "Health",
+            .size = 8,
+            .alignment = 4,
+            .fields = {{"current", 0, 4}, {"max", 4, 4}}};
+}
+
+void damage(std::byte* p)
+{
+    float current;
+    std::memcpy(&current, p, sizeof(current));
+    current -= 1.0f;
+    std::memcpy(p, &current, sizeof(current));
+}
+}  // namespace
+
+// The old bolt-on: component name -> entity index -> bytes
+static void BM_Runtime_MapOfMaps(benchmark::State& state)
+{
+    const auto count = static_cast<uint32_t>(state.range(0));
+    std::unordered_map<std::string, std::unordered_map<uint32_t, std::vector<std::byte>>> store;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        store["Health"][i].resize(8);
+    }
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        for (auto& [index, bytes] : store.at("Health"))
+        {
+            damage(bytes.data());
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Runtime_MapOfMaps)->Range(1000, 100000);
+
+static void BM_Runtime_View(benchmark::State& state)
+{
+    acorn::World world;
+    const auto health = world.register_component(health_layout());
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        world.runtime_pool(health).emplace(world.create_entity());
+    }
+
+    const acorn::RuntimeComponentId include[] = {health};
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.runtime_view(include).each([](acorn::Entity, std::span<std::byte* const> row)
+                                         { damage(row[0]); });
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Runtime_View)->Range(1000, 100000);
+
+// What a VM batch kernel sees: one contiguous span walked by stride
+static void BM_Runtime_Bytes(benchmark::State& state)
+{
+    acorn::World world;
+    const auto health = world.register_component(health_layout());
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        world.runtime_pool(health).emplace(world.create_entity());
+    }
+
+    acorn::RuntimePool& pool = world.runtime_pool(health);
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        const auto bytes = pool.bytes();
+        for (size_t offset = 0; offset < bytes.size(); offset += pool.stride())
+        {
+            damage(bytes.data() + offset);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Runtime_Bytes)->Range(1000, 100000);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "heap_tracker.hpp"
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// range(0) entities spread over 64 distinct 256-byte material descriptors. Each iteration
+// derives a shading key from the material, once per entity or once per distinct material,
+// and accumulates it into the entity's Transform.
+
+namespace
+{
+constexpr int kMaterials = 64;
+
+struct Material
+{
+    std::array<uint32_t, 64> params{};
+
+    bool operator==(const Material&) const = default;
+};
+
+struct MaterialHash
+{
+    size_t operator()(const Material& m) const noexcept
+    {
+        size_t h = 0;
+        for (const uint32_t p : m.params)
+        {
+            h = h * 31 + p;
+        }
+        return h;
+    }
+};
+
+struct Transform
+{
+    float x = 0.0f;
+};
+
+Material make_material(int id)
+{
+    Material m;
+    for (size_t i = 0; i < m.params.size(); ++i)
+    {
+        m.params[i] = static_cast<uint32_t>(id * 131 + i);
+    }
+    return m;
+}
+
+float shading_key(const Material& m)
+{
+    uint32_t key = 0;
+    for (const uint32_t p : m.params)
+    {
+        key ^= p;
+    }
+    return static_cast<float>(key & 0xFF);
+}
+}  // namespace
+
+template <>
+struct std::hash<Material> : MaterialHash
+{
+};
+
+static void BM_Shared_PerEntityCopy(benchmark::State& state)
+{
+    const int64_t heap_before = acorn_bench::heap_in_use();
+    acorn::World world;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        const acorn::Entity e = world.create_entity();
+        world.add<Material>(e, make_material(static_cast<int>(i % kMaterials)));
+        world.add<Transform>(e);
+    }
+    state.counters["heap_bytes"] =
+        static_cast<double>(acorn_bench::heap_in_use() - heap_before);
+
+    auto view = world.view<Material, Transform>();
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each([](acorn::Entity, const Material& m, Transform& t) { t.x += shading_key(m); });
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Shared_PerEntityCopy)->Range(1000, 100000);
+
+static void BM_Shared_Grouped(benchmark::State& state)
+{
+    const int64_t heap_before = acorn_bench::heap_in_use();
+    acorn::World world;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        const acorn::Entity e = world.create_entity();
+        world.shared<Material>().emplace(e, make_material(static_cast<int>(i % kMaterials)));
+        world.add<Transform>(e);
+    }
+    state.counters["heap_bytes"] =
+        static_cast<double>(acorn_bench::heap_in_use() - heap_before);
+
+    auto view = world.view_shared<Material, Transform>();
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        view.each_group(
+            [](const Material& m, auto& group)
+            {
+                const float key = shading_key(m);
+                group.each([key](acorn::Entity, Transform& t) { t.x += key; });
+            });
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_Shared_Grouped)->Range(1000, 100000);
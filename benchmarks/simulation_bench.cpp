@@ -0,0 +1,306 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "heap_tracker.hpp"
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// A particle-system tick that exercises everything together: emitters spawning, several systems
+// with different selectivity, lifetime expiry through defer_destroy, and a flush per frame.
+// Each benchmark iteration is one tick.
+
+namespace
+{
+struct SimPosition
+{
+    float x, y, z;
+};
+
+struct SimVelocity
+{
+    float dx, dy, dz;
+};
+
+struct SimAcceleration
+{
+    float ax, ay, az;
+};
+
+struct SimLifetime
+{
+    float remaining;
+};
+
+struct SimMass
+{
+    float value;
+};
+
+struct SimColor
+{
+    float r, g, b, a;
+};
+
+struct SimDrag
+{
+    float k;
+};
+
+struct SimCollider
+{
+    float radius;
+};
+
+struct SimEmitter
+{
+    uint32_t rate;
+    float speed;
+};
+
+struct SimAttractor
+{
+    float strength;
+};
+
+constexpr float kDt = 1.0f / 60.0f;
+constexpr float kBounds = 100.0f;
+
+// Cheap deterministic generator so runs are comparable across commits.
+struct Lcg
+{
+    uint32_t state;
+
+    float next01() noexcept
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+class ParticleSim
+{
+public:
+    explicit ParticleSim(size_t population) : rng_{12345u}
+    {
+        // Lifetimes average ~2s and emitters replace what expires, so the population hovers
+        // around the requested size once warmed up.
+        const size_t emitters = std::max<size_t>(1, population / 1000);
+        const auto rate = static_cast<uint32_t>(population / (emitters * 120) + 1);
+
+        for (size_t i = 0; i < emitters; ++i)
+        {
+            auto e = world_.create_entity();
+            world_.add<SimPosition>(e, rng_.next01() * kBounds, rng_.next01() * kBounds, 0.0f);
+            world_.add<SimEmitter>(e, rate, 5.0f);
+            if (i % 4 == 0)
+                world_.add<SimAttractor>(e, 2.0f);
+        }
+
+        for (size_t i = 0; i < population; ++i)
+        {
+            spawn_particle(rng_.next01() * kBounds, rng_.next01() * kBounds, 5.0f);
+        }
+    }
+
+    void tick()
+    {
+        emit();
+        integrate();
+        apply_drag();
+        attract();
+        collide();
+        fade();
+        age();
+        world_.flush();
+    }
+
+    size_t population()
+    {
+        return world_.pool<SimLifetime>().size();
+    }
+
+private:
+    void spawn_particle(float x, float y, float speed)
+    {
+        auto e = world_.create_entity();
+        world_.add<SimPosition>(e, x, y, 0.0f);
+        world_.add<SimVelocity>(e, (rng_.next01() - 0.5f) * speed, (rng_.next01() - 0.5f) * speed,
+                                rng_.next01() * speed);
+        world_.add<SimAcceleration>(e, 0.0f, 0.0f, -9.8f);
+        world_.add<SimLifetime>(e, 1.0f + rng_.next01() * 2.0f);
+        world_.add<SimColor>(e, 1.0f, 1.0f, 1.0f, 1.0f);
+
+        const float roll = rng_.next01();
+        if (roll < 0.5f)
+            world_.add<SimMass>(e, 1.0f + roll);
+        if (roll < 0.3f)
+            world_.add<SimDrag>(e, 0.1f);
+        if (roll < 0.1f)
+            world_.add<SimCollider>(e, 0.5f);
+    }
+
+    void emit()
+    {
+        pending_.clear();
+        world_.view<SimPosition, SimEmitter>().each(
+            [&](acorn::Entity, SimPosition& pos, SimEmitter& em)
+            {
+                for (uint32_t i = 0; i < em.rate; ++i)
+                {
+                    pending_.push_back({pos.x, pos.y, em.speed});
+                }
+            });
+
+        // Spawning inside each() would grow the pools being iterated
+        for (const auto& s : pending_)
+        {
+            spawn_particle(s.x, s.y, s.speed);
+        }
+    }
+
+    void integrate()
+    {
+        world_.view<SimPosition, SimVelocity, SimAcceleration>().each(
+            [](acorn::Entity, SimPosition& p, SimVelocity& v, SimAcceleration& a)
+            {
+                v.dx += a.ax * kDt;
+                v.dy += a.ay * kDt;
+                v.dz += a.az * kDt;
+                p.x += v.dx * kDt;
+                p.y += v.dy * kDt;
+                p.z += v.dz * kDt;
+            });
+    }
+
+    void apply_drag()
+    {
+        world_.view<SimVelocity, SimDrag, SimMass>().each(
+            [](acorn::Entity, SimVelocity& v, SimDrag& d, SimMass& m)
+            {
+                const float f = 1.0f - d.k * kDt / m.value;
+                v.dx *= f;
+                v.dy *= f;
+                v.dz *= f;
+            });
+    }
+
+    void attract()
+    {
+        attractors_.clear();
+        world_.view<SimPosition, SimAttractor>().each(
+            [&](acorn::Entity, SimPosition& p, SimAttractor& a)
+            { attractors_.push_back({p.x, p.y, a.strength}); });
+
+        world_.view_exclude<SimAcceleration, SimMass>(acorn::Exclude<SimDrag>{})
+            .each(
+                [&](acorn::Entity e, SimAcceleration& acc, SimMass& m)
+                {
+                    const auto& p = world_.get<SimPosition>(e);
+                    acc.ax = 0.0f;
+                    acc.ay = 0.0f;
+                    for (const auto& at : attractors_)
+                    {
+                        acc.ax += (at.x - p.x) * at.strength / (m.value * kBounds);
+                        acc.ay += (at.y - p.y) * at.strength / (m.value * kBounds);
+                    }
+                });
+    }
+
+    void collide()
+    {
+        world_.view<SimPosition, SimVelocity, SimCollider>().each(
+            [](acorn::Entity, SimPosition& p, SimVelocity& v, SimCollider& c)
+            {
+                if (p.z < c.radius)
+                {
+                    p.z = c.radius;
+                    v.dz = -v.dz * 0.5f;
+                }
+            });
+    }
+
+    void fade()
+    {
+        world_.view<SimColor, SimLifetime>().each([](acorn::Entity, SimColor& c, SimLifetime& l)
+                                                  { c.a = std::min(1.0f, l.remaining); });
+    }
+
+    void age()
+    {
+        world_.view<SimLifetime>().each(
+            [&](acorn::Entity e, SimLifetime& l)
+            {
+                l.remaining -= kDt;
+                if (l.remaining <= 0.0f)
+                    world_.defer_destroy(e);
+            });
+    }
+
+    struct Spawn
+    {
+        float x, y, speed;
+    };
+
+    struct Attractor
+    {
+        float x, y, strength;
+    };
+
+    acorn::World world_;
+    Lcg rng_;
+    std::vector<Spawn> pending_;
+    std::vector<Attractor> attractors_;
+};
+
+double percentile(const std::vector<double>& sorted, double q)
+{
+    if (sorted.empty())
+        return 0.0;
+    const auto rank = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1));
+    return sorted[rank];
+}
+}  // namespace
+
+static void BM_Simulation_ParticleTick(benchmark::State& state)
+{
+    const auto population = static_cast<size_t>(state.range(0));
+
+    std::vector<double> tick_ns;
+    tick_ns.reserve(static_cast<size_t>(state.max_iterations));
+
+    const int64_t heap_before = acorn_bench::heap_in_use();
+    acorn_bench::reset_heap_peak();
+
+    ParticleSim sim(population);
+
+    // Run past the first lifetime wave so spawn/despawn churn is in steady state
+    for (int i = 0; i < 240; ++i)
+    {
+        sim.tick();
+    }
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        sim.tick();
+        const auto stop = std::chrono::steady_clock::now();
+
+        tick_ns.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+
+    std::sort(tick_ns.begin(), tick_ns.end());
+    state.counters["tick_p50_ns"] = percentile(tick_ns, 0.50);
+    state.counters["tick_p90_ns"] = percentile(tick_ns, 0.90);
+    state.counters["tick_p99_ns"] = percentile(tick_ns, 0.99);
+    state.counters["tick_max_ns"] = tick_ns.empty() ? 0.0 : tick_ns.back();
+    state.counters["population"] = static_cast<double>(sim.population());
+    state.counters["peak_heap_bytes"] =
+        static_cast<double>(acorn_bench::heap_peak() - heap_before);
+}
+
+BENCHMARK(BM_Simulation_ParticleTick)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
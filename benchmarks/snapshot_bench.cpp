@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "snapshot.hpp"
+#include "world.hpp"
+
+// End-of-tick hand-off of Position and Orientation to a render thread, range(0) entities.
+// Measured on the simulation thread, which is what the hand-off stalls.
+
+namespace
+{
+struct Position
+{
+    float x, y, z;
+};
+
+struct Orientation
+{
+    float x, y, z, w;
+};
+
+void populate(acorn::World& world, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, 1.0f, 2.0f, 3.0f);
+        world.add<Orientation>(e, 0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+}  // namespace
+
+// The old pattern: the render copy is refreshed through View::each under a shared lock
+static void BM_Snapshot_LockedCopy(benchmark::State& state)
+{
+    acorn::World world;
+    populate(world, state.range(0));
+
+    std::mutex mutex;
+    std::vector<std::pair<acorn::Entity, Position>> positions;
+    std::vector<std::pair<acorn::Entity, Orientation>> orientations;
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        std::lock_guard lock(mutex);
+        positions.clear();
+        orientations.clear();
+        world.view<Position>().each([&](acorn::Entity e, const Position& p)
+                                    { positions.emplace_back(e, p); });
+        world.view<Orientation>().each([&](acorn::Entity e, const Orientation& o)
+                                       { orientations.emplace_back(e, o); });
+        benchmark::DoNotOptimize(positions.data());
+    }
+}
+
+BENCHMARK(BM_Snapshot_LockedCopy)->Range(1000, 100000);
+
+// Positions moved this tick, orientations did not
+static void BM_Snapshot_PublishOneChanged(benchmark::State& state)
+{
+    acorn::World world;
+    populate(world, state.range(0));
+    acorn::SnapshotPublisher<Position, Orientation> publisher(world);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        world.pool<Position>().mark_modified();
+        auto snapshot = publisher.publish();
+        benchmark::DoNotOptimize(snapshot.get());
+    }
+}
+
+BENCHMARK(BM_Snapshot_PublishOneChanged)->Range(1000, 100000);
+
+static void BM_Snapshot_PublishUnchanged(benchmark::State& state)
+{
+    acorn::World world;
+    populate(world, state.range(0));
+    acorn::SnapshotPublisher<Position, Orientation> publisher(world);
+    publisher.publish();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto snapshot = publisher.publish();
+        benchmark::DoNotOptimize(snapshot.get());
+    }
+}
+
+BENCHMARK(BM_Snapshot_PublishUnchanged)->Range(1000, 100000);
+
+// Reader side: grab the latest snapshot and walk the positions
+static void BM_Snapshot_AcquireAndRead(benchmark::State& state)
+{
+    acorn::World world;
+    populate(world, state.range(0));
+    acorn::SnapshotPublisher<Position, Orientation> publisher(world);
+    publisher.publish();
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto snapshot = publisher.acquire();
+        float sum = 0.0f;
+        for (const Position& p : snapshot->pool<Position>().components())
+        {
+            sum += p.x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_Snapshot_AcquireAndRead)->Range(1000, 100000);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "world.hpp"
+
+// Bulk spawning from a prefab and whole-world copies
+
+namespace
+{
+template <int N>
+struct SpawnPart
+{
+    float a, b, c, d;
+};
+
+using PrefabParts = std::make_integer_sequence<int, 12>;
+
+template <int... Ns>
+acorn::Entity make_source(acorn::World& world, std::integer_sequence<int, Ns...>)
+{
+    auto e = world.create_entity();
+    (world.add<SpawnPart<Ns>>(e, float(Ns), 0.0f, 0.0f, 1.0f), ...);
+    return e;
+}
+
+template <int... Ns>
+void add_one_by_one(acorn::World& world, size_t count, std::integer_sequence<int, Ns...>)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto e = world.create_entity();
+        (world.add<SpawnPart<Ns>>(e, float(Ns), 0.0f, 0.0f, 1.0f), ...);
+    }
+}
+}  // namespace
+
+// range(0) copies of a 12-component entity, spawned through World::add (range(1) == 0) or a
+// prefab (range(1) == 1), into a world that already holds 10k of them
+static void BM_Spawn_Prefab(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const bool prefab = state.range(1) != 0;
+
+    std::optional<acorn::World> world;
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        perf.pause_timing();
+        world.emplace();
+        const auto source = make_source(*world, PrefabParts{});
+        add_one_by_one(*world, 10000, PrefabParts{});
+        const auto blueprint = world->make_prefab(source);
+        perf.resume_timing();
+
+        if (prefab)
+            benchmark::DoNotOptimize(world->instantiate(blueprint, count));
+        else
+            add_one_by_one(*world, count, PrefabParts{});
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_Spawn_Prefab)->ArgsProduct({{500, 10000}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+static void BM_World_Copy(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+
+    acorn::World world;
+    add_one_by_one(world, count, PrefabParts{});
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        acorn::World copy(world);
+        benchmark::DoNotOptimize(copy);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+BENCHMARK(BM_World_Copy)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "static_world.hpp"
+#include "world.hpp"
+
+// The same workloads on World and on StaticWorld over eight component types
+
+namespace
+{
+template <int N>
+struct C
+{
+    float value;
+};
+
+using Static = acorn::StaticWorld<C<0>, C<1>, C<2>, C<3>, C<4>, C<5>, C<6>, C<7>>;
+
+// Every entity gets the first two components; the other pools exist but stay empty
+template <typename WorldType>
+std::vector<acorn::Entity> populate(WorldType& world, size_t count)
+{
+    std::vector<acorn::Entity> entities;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto e = world.create_entity();
+        world.template add<C<0>>(e, 1.0f);
+        world.template add<C<1>>(e, 2.0f);
+        entities.push_back(e);
+    }
+    [&]<int... Is>(std::integer_sequence<int, Is...>)
+    { (world.template pool<C<Is>>(), ...); }(std::make_integer_sequence<int, 8>{});
+    return entities;
+}
+
+template <typename WorldType>
+void spawn_destroy(benchmark::State& state)
+{
+    WorldType world;
+    populate(world, 1000);
+
+    acorn_bench::PerfCounters perf{state};
+    for (auto _ : state)
+    {
+        auto e = world.create_entity();
+        world.template add<C<0>>(e, 1.0f);
+        world.template add<C<1>>(e, 2.0f);
+        world.destroy_entity(e);
+    }
+}
+
+template <typename WorldType>
+void random_get(benchmark::State& state)
+{
+    WorldType world;
+    const auto entities = populate(world, static_cast<size_t>(state.range(0)));
+
+    acorn_bench::PerfCounters perf{state};
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const acorn::Entity e = entities[(i++ * 7919) % entities.size()];
+        benchmark::DoNotOptimize(world.template get<C<1>>(e).value);
+    }
+}
+}  // namespace
+
+static void BM_World_SpawnDestroy(benchmark::State& state)
+{
+    spawn_destroy<acorn::World>(state);
+}
+
+BENCHMARK(BM_World_SpawnDestroy);
+
+static void BM_StaticWorld_SpawnDestroy(benchmark::State& state)
+{
+    spawn_destroy<Static>(state);
+}
+
+BENCHMARK(BM_StaticWorld_SpawnDestroy);
+
+static void BM_World_Get(benchmark::State& state)
+{
+    random_get<acorn::World>(state);
+}
+
+BENCHMARK(BM_World_Get)->Arg(1000)->Arg(100000);
+
+static void BM_StaticWorld_Get(benchmark::State& state)
+{
+    random_get<Static>(state);
+}
+
+BENCHMARK(BM_StaticWorld_Get)->Arg(1000)->Arg(100000);
@@ -0,0 +1,12 @@
+#pragma once
+
+// Read prefetch into all cache levels. Compiles to nothing where no hint is available, so it is
+// always safe to call with an address that may never be dereferenced.
+#if defined(__GNUC__) || defined(__clang__)
+    #define ACORN_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <xmmintrin.h>
+    #define ACORN_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+    #define ACORN_PREFETCH(addr) (void)(addr)
+#endif
@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "acorn_assert.hpp"
+#include "entity.hpp"
+
+namespace acorn
+{
+// Secondary index over the components of one pool. The pool reports every component it gains
+// or loses, so an index never has to be refreshed by hand.
+template <typename T, typename Traits>
+class PoolIndex
+{
+public:
+    using entity_type = BasicEntity<Traits>;
+
+    virtual ~PoolIndex() = default;
+
+    // Insertion takes two steps so a pool can update all of its indexes or none of them.
+    // prepare_insert() does whatever can throw, projecting the key included, and is followed
+    // by exactly one commit_insert() or cancel_insert(). Neither of those can fail, and nor can
+    // removal, which works from what the index stored for `e` rather than the current value.
+    virtual void prepare_insert(entity_type e, const T& value) = 0;
+    virtual void commit_insert(entity_type e) noexcept = 0;
+    virtual void cancel_insert() noexcept = 0;
+    virtual void on_remove(entity_type e) noexcept = 0;
+    virtual void on_clear() noexcept = 0;
+};
+
+// Equality lookups on proj(component). find, insert and remove are O(1) on average.
+template <typename T, typename Traits, typename Projection>
+class HashIndex final : public PoolIndex<T, Traits>
+{
+public:
+    using entity_type = BasicEntity<Traits>;
+    using key_type = std::remove_cvref_t<std::invoke_result_t<const Projection&, const T&>>;
+
+    explicit HashIndex(Projection proj) : proj_(std::move(proj)) {}
+
+    // Every entity whose component projects to `key`, in no particular order. Invalidated by
+    // the next change to the pool.
+    std::span<const entity_type> find(const key_type& key) const
+    {
+        auto it = buckets_.find(key);
+        if (it == buckets_.end())
+            return {};
+        return it->second;
+    }
+
+    entity_type find_one(const key_type& key) const
+    {
+        const auto found = find(key);
+        return found.empty() ? entity_type::null() : found.front();
+    }
+
+    size_t count(const key_type& key) const
+    {
+        return find(key).size();
+    }
+
+    // Finds or adds the key's bucket and makes room in it for one more entity
+    void prepare_insert(entity_type e, const T& value) override
+    {
+        if (e.index >= where_.size())
+            where_.resize(e.index + 1);
+
+        auto [it, added] = buckets_.try_emplace(std::invoke(proj_, value));
+        auto& bucket = it->second;
+        if (bucket.size() == bucket.capacity())
+        {
+            try
+            {
+                bucket.reserve(std::max<size_t>(4, bucket.size() * 2));
+            }
+            catch (...)
+            {
+                if (added)
+                    buckets_.erase(it);
+                throw;
+            }
+        }
+        pending_ = it;
+        inserting_ = true;
+    }
+
+    void commit_insert(entity_type e) noexcept override
+    {
+        auto& bucket = pending_->second;
+        where_[e.index] = {pending_, static_cast<uint32_t>(bucket.size())};
+        bucket.push_back(e);
+        inserting_ = false;
+    }
+
+    void cancel_insert() noexcept override
+    {
+        if (pending_->second.empty())
+            buckets_.erase(pending_);
+        inserting_ = false;
+    }
+
+    // Swap-and-pop out of the bucket stored for `e`, dropping the bucket once it empties
+    // unless a pending insertion is about to reuse it
+    void on_remove(entity_type e) noexcept override
+    {
+        const Where where = where_[e.index];
+        auto& bucket = where.bucket->second;
+        ACORN_ASSERT(bucket[where.at] == e);
+
+        bucket[where.at] = bucket.back();
+        where_[bucket[where.at].index].at = where.at;
+        bucket.pop_back();
+
+        if (bucket.empty() && !(inserting_ && where.bucket == pending_))
+            buckets_.erase(where.bucket);
+    }
+
+    void on_clear() noexcept override
+    {
+        buckets_.clear();
+    }
+
+private:
+    using map_type = std::unordered_map<key_type, std::vector<entity_type>>;
+
+    // An entity's bucket and its place in it. Node iterators of unordered_map survive
+    // rehashing, so they stay valid until their bucket is erased.
+    struct Where
+    {
+        typename map_type::iterator bucket;
+        uint32_t at;
+    };
+
+    Projection proj_;
+    map_type buckets_;
+    // By entity index
+    std::vector<Where> where_;
+    typename map_type::iterator pending_;
+    bool inserting_ = false;
+};
+
+// Ordered lookups and range queries on proj(component). Insert and range lookup are
+// O(log n); removal is O(1) amortised through the iterator kept per entity.
+template <typename T, typename Traits, typename Projection>
+class SortedIndex final : public PoolIndex<T, Traits>
+{
+public:
+    using entity_type = BasicEntity<Traits>;
+    using key_type = std::remove_cvref_t<std::invoke_result_t<const Projection&, const T&>>;
+
+    explicit SortedIndex(Projection proj) : proj_(std::move(proj)) {}
+
+    size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    entity_type find_one(const key_type& key) const
+    {
+        auto it = entries_.find(key);
+        return it == entries_.end() ? entity_type::null() : it->second;
+    }
+
+    // Calls f(entity) for every key in [lo, hi), in key order
+    template <typename Func>
+    void each_in_range(const key_type& lo, const key_type& hi, Func&& f) const
+    {
+        for (auto it = entries_.lower_bound(lo); it != entries_.end() && it->first < hi; ++it)
+        {
+            f(it->second);
+        }
+    }
+
+    std::vector<entity_type> range(const key_type& lo, const key_type& hi) const
+    {
+        std::vector<entity_type> out;
+        each_in_range(lo, hi, [&](entity_type e) { out.push_back(e); });
+        return out;
+    }
+
+    // The entry goes into the map straight away; commit_insert() only records where it is
+    void prepare_insert(entity_type e, const T& value) override
+    {
+        if (e.index >= where_.size())
+            where_.resize(e.index + 1);
+        pending_ = entries_.emplace(std::invoke(proj_, value), e);
+    }
+
+    void commit_insert(entity_type e) noexcept override
+    {
+        where_[e.index] = pending_;
+    }
+
+    void cancel_insert() noexcept override
+    {
+        entries_.erase(pending_);
+    }
+
+    void on_remove(entity_type e) noexcept override
+    {
+        ACORN_ASSERT(where_[e.index]->second == e);
+        entries_.erase(where_[e.index]);
+    }
+
+    void on_clear() noexcept override
+    {
+        entries_.clear();
+    }
+
+private:
+    using map_type = std::multimap<key_type, entity_type>;
+
+    Projection proj_;
+    map_type entries_;
+    // Each indexed entity's node in entries_, by entity index
+    std::vector<typename map_type::iterator> where_;
+    typename map_type::iterator pending_;
+};
+}  // namespace acorn
@@ -1,19 +1,37 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include "acorn_assert.hpp"
+#include "acorn_prefetch.hpp"
+#include "component_index.hpp"
+#include "dynamic_bitset.hpp"
 #include "entity_manager.hpp"
+#include "pool_storage.hpp"
 
 namespace acorn
 {
-template <typename T>
+template <typename T, typename Traits = DefaultEntityTraits, typename Storage = VectorStorage>
 class ComponentPool
 {
+    template <typename U>
+    using array_type = typename Storage::template array<U>;
+
 public:
-    explicit ComponentPool(const EntityManager& em, size_t reserve_hint = 0) noexcept : em_(em)
+    using value_type = T;
+    using entity_type = BasicEntity<Traits>;
+    using entity_manager_type = BasicEntityManager<Traits>;
+    using storage_type = Storage;
+
+    static constexpr uint32_t kAbsent = UINT32_MAX;
+
+    explicit ComponentPool(const entity_manager_type& em, size_t reserve_hint = 0) noexcept
+        : em_(em)
     {
         if (reserve_hint)
         {
@@ -23,7 +41,30 @@ public:
         }
     }
 
-    bool has(Entity e) const noexcept
+    // Pool whose arrays come from `storage`, e.g. MappedStorage for file-backed pools
+    ComponentPool(const entity_manager_type& em, const Storage& storage)
+        : em_(em),
+          dense_entities_(storage.template make<entity_type>("entities", AccessHint::Sequential)),
+          dense_data_(storage.template make<T>("data", AccessHint::Sequential)),
+          sparse_(storage.template make<uint32_t>("sparse", AccessHint::Random))
+    {
+    }
+
+    // Copies `other` into a pool bound to a different entity manager, e.g. the one of a cloned
+    // World. The storage is copied wholesale, a memcpy for trivially copyable components.
+    // Secondary indexes are not copied; add them again on the copy if needed.
+    ComponentPool(const entity_manager_type& em, const ComponentPool& other)
+        : em_(em),
+          dense_entities_(other.dense_entities_),
+          dense_data_(other.dense_data_),
+          sparse_(other.sparse_),
+          presence_(other.presence_),
+          tracks_presence_(other.tracks_presence_),
+          version_(other.version_)
+    {
+    }
+
+    bool has(entity_type e) const noexcept
     {
         if (!em_.is_alive(e))
             return false;
@@ -37,22 +78,23 @@ public:
         return dense_entities_[pos] == e;
     }
 
-    T* try_get(Entity e) noexcept
+    T* try_get(entity_type e) noexcept
     {
         if (!has(e))
             return nullptr;
 
+        ++version_;
         return &dense_data_[sparse_[e.index]];
     }
 
-    const T* try_get(Entity e) const noexcept
+    const T* try_get(entity_type e) const noexcept
     {
         if (!has(e))
             return nullptr;
         return &dense_data_[sparse_[e.index]];
     }
 
-    [[nodiscard]] T& get(Entity e)
+    [[nodiscard]] T& get(entity_type e)
     {
         if (auto* p = try_get(e))
             return *p;
@@ -60,7 +102,7 @@ public:
             "acorn::ComponentPool: entity does not have the requested component");
     }
 
-    [[nodiscard]] const T& get(Entity e) const
+    [[nodiscard]] const T& get(entity_type e) const
     {
         if (auto* p = try_get(e))
             return *p;
@@ -68,23 +110,96 @@ public:
             "acorn::ComponentPool: entity does not have the requested component");
     }
 
-    [[nodiscard]] const std::vector<Entity>& entities() const noexcept
+    const entity_manager_type& entity_manager() const noexcept
+    {
+        return em_;
+    }
+
+    [[nodiscard]] const array_type<entity_type>& entities() const noexcept
     {
         return dense_entities_;
     }
 
+    // The sparse array itself, by entity index, for kernels that resolve many entities at once
+    std::span<const uint32_t> sparse() const noexcept
+    {
+        return {sparse_.data(), sparse_.size()};
+    }
+
+    // Unchecked lookup for iteration code that already holds a live entity, e.g. one read from
+    // another pool's dense array: no liveness or generation test, only the sparse slot.
+    // Returns the dense position, or kAbsent when the entity has no component here.
+    uint32_t position(entity_type e) const noexcept
+    {
+        return e.index < sparse_.size() ? sparse_[e.index] : kAbsent;
+    }
+
+    // Does not bump version(): callers writing through it call mark_modified() once up front
+    T& data_at(size_t pos) noexcept
+    {
+        ACORN_ASSERT(pos < dense_data_.size());
+        return dense_data_[pos];
+    }
+
+    const T& data_at(size_t pos) const noexcept
+    {
+        ACORN_ASSERT(pos < dense_data_.size());
+        return dense_data_[pos];
+    }
+
+    // First stage of a pipelined lookup: pulls the sparse slot for `e` into cache
+    void prefetch_sparse(entity_type e) const noexcept
+    {
+        if (e.index < sparse_.size())
+            ACORN_PREFETCH(&sparse_[e.index]);
+    }
+
+    // Second stage: resolves the dense slot (cheap once prefetch_sparse has landed) and pulls
+    // the component and its back-reference into cache
+    void prefetch_component(entity_type e) const noexcept
+    {
+        if (e.index >= sparse_.size())
+            return;
+
+        const uint32_t pos = sparse_[e.index];
+        if (pos == kAbsent)
+            return;
+
+        ACORN_PREFETCH(&dense_entities_[pos]);
+        ACORN_PREFETCH(&dense_data_[pos]);
+    }
+
     template <typename... Args>
-    T& emplace(Entity e, Args&&... args)
+    T& emplace(entity_type e, Args&&... args)
     {
         ACORN_ASSERT(em_.is_alive(e));
 
         grow_sparse_to_fit(e.index);
+        ++version_;
 
         // Overwrite policy, if the entity already has the component we overwrite it
         if (has(e))
         {
             auto pos = sparse_[e.index];
-            dense_data_[pos] = T(std::forward<Args>(args)...);
+            T value(std::forward<Args>(args)...);
+
+            // Whatever can throw happens before the old key leaves an index, so a failed
+            // overwrite leaves the indexes as they were
+            prepare_indexes(e, value);
+            try
+            {
+                dense_data_[pos] = std::move(value);
+            }
+            catch (...)
+            {
+                cancel_indexes();
+                throw;
+            }
+            for (auto& index : indexes_)
+            {
+                index->on_remove(e);
+                index->commit_insert(e);
+            }
 
 #ifndef NDEBUG
             debug_check_invariants();
@@ -98,6 +213,17 @@ public:
             dense_entities_.push_back(e);
             dense_data_.emplace_back(std::forward<Args>(args)...);
             sparse_[e.index] = pos;
+            if (tracks_presence_)
+                presence_.set(e.index);
+            try
+            {
+                notify_insert(e, dense_data_.back());
+            }
+            catch (...)
+            {
+                unwind_to(pos, 0);
+                throw;
+            }
 
 #ifndef NDEBUG
             debug_check_invariants();
@@ -106,26 +232,57 @@ public:
         }
     }
 
-    bool remove(Entity e) noexcept
+    // Gives each of `entities` a copy of `value`. They must be alive, distinct and not have the
+    // component yet. The sparse array grows and the dense arrays reserve once for the batch.
+    void emplace_many(std::span<const entity_type> entities, const T& value)
     {
-        if (!has(e))
-            return false;
-        auto pos = sparse_[e.index];
-        auto last = static_cast<uint32_t>(dense_data_.size() - 1);
+        if (entities.empty())
+            return;
 
-        if (pos != last)
+        uint32_t max_index = 0;
+        for (const entity_type e : entities)
         {
-            const Entity moved = dense_entities_[last];
+            ACORN_ASSERT(em_.is_alive(e) && position(e) == kAbsent);
+            max_index = std::max<uint32_t>(max_index, e.index);
+        }
+        grow_sparse_to_fit(max_index);
+        ++version_;
 
-            dense_data_[pos] = std::move(dense_data_[last]);
-            dense_entities_[pos] = moved;
-            sparse_[moved.index] = pos;
+        const auto base = static_cast<uint32_t>(dense_data_.size());
+        dense_entities_.insert(dense_entities_.end(), entities.begin(), entities.end());
+        dense_data_.insert(dense_data_.end(), entities.size(), value);
+
+        for (uint32_t i = 0; i < entities.size(); ++i)
+        {
+            sparse_[entities[i].index] = base + i;
+            if (tracks_presence_)
+                presence_.set(entities[i].index);
+        }
+        for (uint32_t i = 0; i < entities.size(); ++i)
+        {
+            try
+            {
+                notify_insert(entities[i], dense_data_[base + i]);
+            }
+            catch (...)
+            {
+                unwind_to(base, i);
+                throw;
+            }
         }
 
-        sparse_[e.index] = kAbsent;
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
+    }
 
-        dense_data_.pop_back();
-        dense_entities_.pop_back();
+    bool remove(entity_type e) noexcept
+    {
+        if (!has(e))
+            return false;
+
+        remove_at(sparse_[e.index]);
+        ++version_;
 
 #ifndef NDEBUG
         debug_check_invariants();
@@ -133,6 +290,121 @@ public:
         return true;
     }
 
+    // Removes every entity of `batch` that has a component here. `batch` must hold live,
+    // distinct entities, and `indices` must have exactly their indices set. Walks whichever is
+    // smaller, the batch or this pool, so a large despawn costs at most O(size()) per pool.
+    size_t remove_many(std::span<const entity_type> batch, const DynamicBitset& indices) noexcept
+    {
+        if (dense_data_.empty() || batch.empty())
+            return 0;
+
+        const size_t before = dense_data_.size();
+
+        if (batch.size() < dense_data_.size())
+        {
+            for (const entity_type e : batch)
+            {
+                const uint32_t pos = position(e);
+                if (pos != kAbsent)
+                    remove_at(pos);
+            }
+        }
+        else
+        {
+            // Backwards, so the element swapped into slot i has already been looked at
+            for (size_t i = dense_entities_.size(); i-- > 0;)
+            {
+                if (indices.test(dense_entities_[i].index))
+                    remove_at(static_cast<uint32_t>(i));
+            }
+        }
+
+        if (dense_data_.size() != before)
+            ++version_;
+
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
+        return before - dense_data_.size();
+    }
+
+    // Adds a secondary index keyed by proj(component), filled from the current contents and
+    // kept up to date by emplace (overwrites included), remove and clear. Writes through a
+    // reference from get() or a view bypass it: re-emplace the component to change a key.
+    // The returned index lives as long as the pool.
+    template <typename Projection>
+    HashIndex<T, Traits, Projection>& add_hash_index(Projection proj)
+    {
+        return add_index(std::make_unique<HashIndex<T, Traits, Projection>>(std::move(proj)));
+    }
+
+    template <typename Projection>
+    SortedIndex<T, Traits, Projection>& add_sorted_index(Projection proj)
+    {
+        return add_index(std::make_unique<SortedIndex<T, Traits, Projection>>(std::move(proj)));
+    }
+
+    // Moves the components of `order`'s entities to the front of the dense arrays, in that
+    // order; entities without one are skipped and the rest of the pool follows in no
+    // particular order. `order` must not repeat an entity. O(order.size()) swaps, e.g. to line
+    // a pool up with Hierarchy::order().
+    void sort_as(std::span<const entity_type> order)
+    {
+        uint32_t next = 0;
+        for (const entity_type e : order)
+        {
+            if (!has(e))
+                continue;
+
+            const uint32_t pos = sparse_[e.index];
+            ACORN_ASSERT(pos >= next);
+            if (pos != next)
+                swap_at(pos, next);
+            ++next;
+        }
+        ++version_;
+
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
+    }
+
+    // Starts keeping a bitset of the entity indices that hold a component here, which
+    // View::each_present intersects 64 entities at a time. Costs one bit write per insertion and
+    // removal from then on. Calling it again is a no-op.
+    void track_presence()
+    {
+        if (tracks_presence_)
+            return;
+
+        for (const entity_type e : dense_entities_)
+        {
+            presence_.set(e.index);
+        }
+        tracks_presence_ = true;
+    }
+
+    // The presence bitset, or nullptr unless track_presence() was called
+    const DynamicBitset* presence() const noexcept
+    {
+        return tracks_presence_ ? &presence_ : nullptr;
+    }
+
+    // Changes whenever the contents may have: on every insertion, overwrite, removal and clear,
+    // on mutable try_get(), get() and begin(), and once per pass of a View holding the pool
+    // mutably. Writes through data_at() need a mark_modified(). Lets SnapshotPublisher skip
+    // unchanged pools.
+    uint64_t version() const noexcept
+    {
+        return version_;
+    }
+
+    // For writes that bypass the tracked paths, e.g. a loop over data_at()
+    void mark_modified() noexcept
+    {
+        ++version_;
+    }
+
     size_t size() const noexcept
     {
         return dense_data_.size();
@@ -148,15 +420,31 @@ public:
         return dense_data_.capacity();
     }
 
+    // O(size()): only the sparse slots of live components are reset, however far the sparse
+    // array once grew. Capacity is kept for whatever is spawned next.
     void clear() noexcept
     {
+        for (const entity_type e : dense_entities_)
+        {
+            sparse_[e.index] = kAbsent;
+            presence_.reset(e.index);
+        }
+        for (auto& index : indexes_)
+        {
+            index->on_clear();
+        }
         dense_entities_.clear();
         dense_data_.clear();
-        std::fill(sparse_.begin(), sparse_.end(), kAbsent);
+        ++version_;
+
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
     }
 
     auto begin() noexcept
     {
+        ++version_;
         return dense_data_.begin();
     }
 
@@ -195,7 +483,7 @@ private:
 
         for (size_t i = 0; i < n; ++i)
         {
-            const Entity e = dense_entities_[i];
+            const entity_type e = dense_entities_[i];
 
             // Must be alive
             ACORN_ASSERT(em_.is_alive(e));
@@ -217,8 +505,127 @@ private:
             ACORN_ASSERT(pos < n);
             ACORN_ASSERT(dense_entities_[pos].index == idx);
         }
+
+        if (tracks_presence_)
+        {
+            for (size_t idx = 0; idx < presence_.size(); ++idx)
+            {
+                const bool present = idx < sparse_.size() && sparse_[idx] != kAbsent;
+                ACORN_ASSERT(presence_.test(idx) == present);
+            }
+        }
     }
 #endif
+    template <typename Index>
+    Index& add_index(std::unique_ptr<Index> index)
+    {
+        for (size_t i = 0; i < dense_data_.size(); ++i)
+        {
+            index->prepare_insert(dense_entities_[i], dense_data_[i]);
+            index->commit_insert(dense_entities_[i]);
+        }
+
+        Index& ref = *index;
+        indexes_.push_back(std::move(index));
+        return ref;
+    }
+
+    // Either every index takes `e` or, on a throw, none does
+    void notify_insert(entity_type e, const T& value)
+    {
+        prepare_indexes(e, value);
+        for (auto& index : indexes_)
+        {
+            index->commit_insert(e);
+        }
+    }
+
+    void prepare_indexes(entity_type e, const T& value)
+    {
+        size_t prepared = 0;
+        try
+        {
+            for (; prepared < indexes_.size(); ++prepared)
+            {
+                indexes_[prepared]->prepare_insert(e, value);
+            }
+        }
+        catch (...)
+        {
+            while (prepared-- > 0)
+            {
+                indexes_[prepared]->cancel_insert();
+            }
+            throw;
+        }
+    }
+
+    void cancel_indexes() noexcept
+    {
+        for (auto& index : indexes_)
+        {
+            index->cancel_insert();
+        }
+    }
+
+    void notify_remove(entity_type e) noexcept
+    {
+        for (auto& index : indexes_)
+        {
+            index->on_remove(e);
+        }
+    }
+
+    // Takes back the insertions from dense position `base` on after one failed; the first
+    // `indexed` of them had reached the indexes
+    void unwind_to(uint32_t base, uint32_t indexed) noexcept
+    {
+        for (uint32_t i = 0; i < indexed; ++i)
+        {
+            notify_remove(dense_entities_[base + i]);
+        }
+        while (dense_entities_.size() > base)
+        {
+            const entity_type e = dense_entities_.back();
+            sparse_[e.index] = kAbsent;
+            presence_.reset(e.index);
+            dense_data_.pop_back();
+            dense_entities_.pop_back();
+        }
+    }
+
+    void swap_at(uint32_t a, uint32_t b)
+    {
+        using std::swap;
+        swap(dense_data_[a], dense_data_[b]);
+        swap(dense_entities_[a], dense_entities_[b]);
+        sparse_[dense_entities_[a].index] = a;
+        sparse_[dense_entities_[b].index] = b;
+    }
+
+    // Swap-and-pop of the component at dense position `pos`
+    void remove_at(uint32_t pos) noexcept
+    {
+        const entity_type e = dense_entities_[pos];
+        const auto last = static_cast<uint32_t>(dense_data_.size() - 1);
+        notify_remove(e);
+
+        if (pos != last)
+        {
+            const entity_type moved = dense_entities_[last];
+
+            dense_data_[pos] = std::move(dense_data_[last]);
+            dense_entities_[pos] = moved;
+            sparse_[moved.index] = pos;
+        }
+
+        sparse_[e.index] = kAbsent;
+        presence_.reset(e.index);
+
+        dense_data_.pop_back();
+        dense_entities_.pop_back();
+    }
+
     void grow_sparse_to_fit(uint32_t index)
     {
         if (index >= sparse_.size())
@@ -227,13 +634,15 @@ private:
         }
     }
 
-    const EntityManager& em_;
+    const entity_manager_type& em_;
 
-    std::vector<Entity> dense_entities_;
-    std::vector<T> dense_data_;
-    std::vector<uint32_t> sparse_;
-
-    static constexpr uint32_t kAbsent = UINT32_MAX;
+    array_type<entity_type> dense_entities_;
+    array_type<T> dense_data_;
+    array_type<uint32_t> sparse_;
+    DynamicBitset presence_;
+    bool tracks_presence_ = false;
+    uint64_t version_ = 0;
+    std::vector<std::unique_ptr<PoolIndex<T, Traits>>> indexes_;
 };
 
 }  // namespace acorn
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace acorn
+{
+// Growable bitset over entity indices. Bits past size() read as 0, and set() grows as needed.
+class DynamicBitset
+{
+public:
+    static constexpr size_t kWordBits = 64;
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t word_count() const noexcept
+    {
+        return words_.size();
+    }
+
+    const uint64_t* data() const noexcept
+    {
+        return words_.data();
+    }
+
+    uint64_t word(size_t w) const noexcept
+    {
+        return w < words_.size() ? words_[w] : 0;
+    }
+
+    bool test(size_t i) const noexcept
+    {
+        return i < size_ && ((words_[i / kWordBits] >> (i % kWordBits)) & 1u);
+    }
+
+    void set(size_t i)
+    {
+        if (i >= size_)
+            resize(i + 1);
+        words_[i / kWordBits] |= uint64_t{1} << (i % kWordBits);
+    }
+
+    // Returns whether the bit was already set
+    bool test_and_set(size_t i)
+    {
+        const bool was = test(i);
+        set(i);
+        return was;
+    }
+
+    void reset(size_t i) noexcept
+    {
+        if (i < size_)
+            words_[i / kWordBits] &= ~(uint64_t{1} << (i % kWordBits));
+    }
+
+    void resize(size_t bits)
+    {
+        words_.resize((bits + kWordBits - 1) / kWordBits, 0);
+        // Shrinking must not leave stale bits behind in the last word
+        if (bits % kWordBits && bits < size_)
+            words_.back() &= (uint64_t{1} << (bits % kWordBits)) - 1;
+        size_ = bits;
+    }
+
+    // Zeroes every bit and keeps the allocation
+    void reset_all() noexcept
+    {
+        std::fill(words_.begin(), words_.end(), 0);
+    }
+
+    void clear() noexcept
+    {
+        words_.clear();
+        size_ = 0;
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    size_t size_ = 0;
+};
+}  // namespace acorn
@@ -3,24 +3,51 @@
 
 namespace acorn
 {
-struct Entity
+// Bit widths of the two halves of an entity handle. Both are uint32_t bit-fields, so a layout
+// whose widths sum to 32 or less packs into a single word, and anything wider takes two.
+// The all-ones index and the all-ones generation are reserved for the null handle.
+template <unsigned IndexBits, unsigned GenerationBits>
+struct EntityTraits
 {
-    uint32_t index{UINT32_MAX};
-    uint32_t generation{UINT32_MAX};
+    static_assert(IndexBits > 0 && IndexBits <= 32, "index must fit in 1..32 bits");
+    static_assert(GenerationBits > 0 && GenerationBits <= 32, "generation must fit in 1..32 bits");
 
-    friend constexpr bool operator==(Entity lhs, Entity rhs) noexcept
+    static constexpr unsigned index_bits = IndexBits;
+    static constexpr unsigned generation_bits = GenerationBits;
+
+    static constexpr uint32_t index_mask =
+        IndexBits == 32 ? UINT32_MAX : (uint32_t{1} << IndexBits) - 1;
+    static constexpr uint32_t generation_mask =
+        GenerationBits == 32 ? UINT32_MAX : (uint32_t{1} << GenerationBits) - 1;
+};
+
+// Two full 32-bit words
+using DefaultEntityTraits = EntityTraits<32, 32>;
+
+// ~1M entities with 4095 reuses per slot, in 4 bytes
+using CompactEntityTraits = EntityTraits<20, 12>;
+
+template <typename Traits = DefaultEntityTraits>
+struct BasicEntity
+{
+    using traits_type = Traits;
+
+    uint32_t index : Traits::index_bits {Traits::index_mask};
+    uint32_t generation : Traits::generation_bits {Traits::generation_mask};
+
+    friend constexpr bool operator==(BasicEntity lhs, BasicEntity rhs) noexcept
     {
         return lhs.index == rhs.index && lhs.generation == rhs.generation;
     }
 
-    friend constexpr bool operator!=(Entity lhs, Entity rhs) noexcept
+    friend constexpr bool operator!=(BasicEntity lhs, BasicEntity rhs) noexcept
     {
         return !(lhs == rhs);
     }
 
-    static constexpr Entity null() noexcept
+    static constexpr BasicEntity null() noexcept
     {
-        return {UINT32_MAX, UINT32_MAX};
+        return {Traits::index_mask, Traits::generation_mask};
     }
 
     constexpr bool is_null() const noexcept
@@ -28,4 +55,9 @@ struct Entity
         return *this == null();
     }
 };
+
+using Entity = BasicEntity<>;
+
+static_assert(sizeof(Entity) == 8);
+static_assert(sizeof(BasicEntity<CompactEntityTraits>) == 4);
 }  // namespace acorn
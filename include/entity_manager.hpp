@@ -1,66 +1,307 @@
 #pragma once
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
+#include "dynamic_bitset.hpp"
 #include "entity.hpp"
 
 namespace acorn
 {
-class EntityManager
+// Which dead slot create() reuses first
+enum class RecyclePolicy
+{
+    // Most recently destroyed first: its sparse slots and components are likely still cached
+    Lifo,
+    // Lowest free index first: keeps live indices, and so every pool's sparse array, short
+    LowestIndex,
+};
+
+template <typename Traits = DefaultEntityTraits>
+class BasicEntityManager
 {
 public:
-    explicit EntityManager(uint32_t max_hint = 0)
+    using traits_type = Traits;
+    using entity_type = BasicEntity<Traits>;
+
+    explicit BasicEntityManager(uint32_t max_hint = 0, RecyclePolicy policy = RecyclePolicy::Lifo)
+        : policy_(policy)
     {
-        generations_.reserve(max_hint ? max_hint : 1024);
+        slots_.reserve(max_hint ? max_hint : 1024);
     }
 
-    Entity create()
+    entity_type create()
     {
-        if (!free_list_.empty())
+        if (free_count_ > 0)
         {
-            uint32_t idx = free_list_.back();
-            free_list_.pop_back();
+            const uint32_t idx =
+                policy_ == RecyclePolicy::Lifo ? pop_free_head() : pop_lowest_free();
+            --free_count_;
 
-            return Entity{idx, generations_[idx]};
+            const entity_type e{idx, slots_[idx].generation};
+            slots_[idx] = e;
+            link_live(idx);
+            return e;
         }
-        uint32_t idx = static_cast<uint32_t>(generations_.size());
-        generations_.push_back(0);
-        return {idx, 0};
+
+        // The all-ones index is the null handle's and is never handed out
+        if (slots_.size() >= Traits::index_mask)
+            throw std::length_error("acorn::EntityManager: entity index space exhausted");
+
+        const auto idx = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(entity_type{idx, 0});
+        live_at_.push_back(0);
+        link_live(idx);
+        return slots_.back();
     }
 
-    bool destroy(Entity e)
+    bool destroy(entity_type e)
     {
         if (!is_alive(e))
             return false;
 
-        ++generations_[e.index];
-        free_list_.push_back(e.index);
+        // Swap-and-pop out of the live list
+        const uint32_t at = live_at_[e.index];
+        const uint32_t moved = live_.back();
+        live_[at] = moved;
+        live_at_[moved] = at;
+        live_.pop_back();
+
+        release(e);
         return true;
     }
 
-    bool is_alive(Entity e) const noexcept
+    // A live slot stores exactly its own handle. A dead one stores the next free index (or the
+    // end-of-list marker), which never equals its own, so comparing the slot is enough
+    bool is_alive(entity_type e) const noexcept
     {
-        return e.index < generations_.size() && e.generation == generations_[e.index];
+        return e.index < slots_.size() && slots_[e.index] == e;
     }
 
     uint32_t alive_count() const noexcept
     {
-        return static_cast<uint32_t>(generations_.size() - free_list_.size());
+        return static_cast<uint32_t>(slots_.size() - free_count_ - retired_);
     }
 
     uint32_t capacity() const noexcept
     {
-        return static_cast<uint32_t>(generations_.size());
+        return static_cast<uint32_t>(slots_.size());
     }
 
+    // A disabled entity stays alive and keeps its components, but views skip it. Toggling is
+    // one bit, with no component data moved; destroying an entity enables its slot again.
+    // Both return false for dead entities and for no-op toggles.
+    bool disable(entity_type e)
+    {
+        if (!is_alive(e) || disabled_.test_and_set(e.index))
+            return false;
+        ++disabled_count_;
+        return true;
+    }
+
+    bool enable(entity_type e) noexcept
+    {
+        if (!is_alive(e) || !disabled_.test(e.index))
+            return false;
+        disabled_.reset(e.index);
+        --disabled_count_;
+        return true;
+    }
+
+    bool is_enabled(entity_type e) const noexcept
+    {
+        return is_alive(e) && !disabled_.test(e.index);
+    }
+
+    uint32_t disabled_count() const noexcept
+    {
+        return disabled_count_;
+    }
+
+    // One bit per slot, set for disabled entities, for iteration code that tests many at once
+    const DynamicBitset& disabled() const noexcept
+    {
+        return disabled_;
+    }
+
+    RecyclePolicy recycle_policy() const noexcept
+    {
+        return policy_;
+    }
+
+    // Destroys every live entity but keeps the slots and their generations, so handles from
+    // before the call stay dead. Costs O(live log live) through the live list, however many
+    // slots lie dead in between.
+    void destroy_all()
+    {
+        // Top down, so that under Lifo the lowest indices are handed out first again
+        std::sort(live_.begin(), live_.end(), std::greater<>{});
+        for (const uint32_t idx : live_)
+        {
+            release(slots_[idx]);
+        }
+        live_.clear();
+    }
+
+    // Brings a fresh manager back in line with saved state, such as the entities() of pools
+    // reopened from MappedStorage: exactly the handles in `alive` are alive afterwards. Other
+    // slots below the highest index start out free at generation 0, so handles that were
+    // already dead when the state was saved are not recognised as stale.
+    void restore(std::span<const entity_type> alive)
+    {
+        if (!slots_.empty())
+            throw std::logic_error("acorn::EntityManager: restore() needs an empty manager");
+
+        uint32_t end = 0;
+        for (const entity_type e : alive)
+        {
+            end = std::max<uint32_t>(end, e.index + 1);
+        }
+
+        // kEndOfList never equals a slot's own index, so this marks every slot dead
+        slots_.assign(end, entity_type{kEndOfList, 0});
+        live_at_.assign(end, 0);
+        for (const entity_type e : alive)
+        {
+            if (slots_[e.index].index == e.index && slots_[e.index] != e)
+            {
+                slots_.clear();
+                throw std::invalid_argument(
+                    "acorn::EntityManager: restore() got two generations for one index");
+            }
+            slots_[e.index] = e;
+        }
+        for (uint32_t idx = 0; idx < end; ++idx)
+        {
+            if (slots_[idx].index == idx)
+                link_live(idx);
+        }
+
+        // Top down, so that under Lifo the lowest free indices are handed out first
+        for (uint32_t idx = end; idx-- > 0;)
+        {
+            if (slots_[idx].index != idx)
+            {
+                slots_[idx] = entity_type{link_free(idx), 0};
+                ++free_count_;
+            }
+        }
+    }
+
+    // Forgets every slot, generations included: handles from before the call may become valid
+    // again. Prefer destroy_all() unless no old handle can survive the reset.
     void reset() noexcept
     {
-        generations_.clear();
-        free_list_.clear();
+        slots_.clear();
+        live_.clear();
+        live_at_.clear();
+        free_bits_.clear();
+        free_head_ = kEndOfList;
+        lowest_free_word_ = 0;
+        free_count_ = 0;
+        retired_ = 0;
+        disabled_.clear();
+        disabled_count_ = 0;
     }
 
 private:
-    std::vector<uint32_t> generations_;
-    std::vector<uint32_t> free_list_;
+    // The null index doubles as the end of the implicit free list
+    static constexpr uint32_t kEndOfList = Traits::index_mask;
+
+    void link_live(uint32_t idx)
+    {
+        live_at_[idx] = static_cast<uint32_t>(live_.size());
+        live_.push_back(idx);
+    }
+
+    // Kills the live entity `e` without touching the live list
+    void release(entity_type e)
+    {
+        if (disabled_count_ != 0 && disabled_.test(e.index))
+        {
+            disabled_.reset(e.index);
+            --disabled_count_;
+        }
+
+        const uint32_t generation = (e.generation + 1) & Traits::generation_mask;
+
+        // Wrapping back to 0 would let a handle from 2^bits reuses ago match again, so a slot
+        // that reaches the reserved generation is retired instead of recycled
+        if (generation == Traits::generation_mask)
+        {
+            slots_[e.index] = entity_type{kEndOfList, generation};
+            ++retired_;
+            return;
+        }
+
+        slots_[e.index] = entity_type{link_free(e.index), generation};
+        ++free_count_;
+    }
+
+    // Slots are always written as whole handles; updating one bit-field at a time costs a
+    // read-modify-write per field and stalls the next read of the slot
+
+    // Records idx as free and returns what its slot's index field should hold. For Lifo that
+    // is the previous list head: the free list is threaded through the dead slots themselves.
+    uint32_t link_free(uint32_t idx)
+    {
+        if (policy_ == RecyclePolicy::Lifo)
+        {
+            const uint32_t next = free_head_;
+            free_head_ = idx;
+            return next;
+        }
+
+        const size_t word = idx / 64;
+        if (word >= free_bits_.size())
+            free_bits_.resize(word + 1, 0);
+        free_bits_[word] |= uint64_t{1} << (idx % 64);
+
+        if (word < lowest_free_word_)
+            lowest_free_word_ = word;
+        return kEndOfList;
+    }
+
+    uint32_t pop_free_head() noexcept
+    {
+        const uint32_t idx = free_head_;
+        free_head_ = slots_[idx].index;
+        return idx;
+    }
+
+    // LowestIndex: one bit per slot, scanned from the lowest word that may hold a set bit.
+    // The hint only moves forward between destroys, so the scan is amortised O(1).
+    uint32_t pop_lowest_free() noexcept
+    {
+        while (free_bits_[lowest_free_word_] == 0)
+        {
+            ++lowest_free_word_;
+        }
+
+        uint64_t& word = free_bits_[lowest_free_word_];
+        const auto bit = static_cast<uint32_t>(std::countr_zero(word));
+        word &= word - 1;
+
+        return static_cast<uint32_t>(lowest_free_word_ * 64) + bit;
+    }
+
+    std::vector<entity_type> slots_;
+    // Indices of the live entities in no particular order, and each one's position there
+    std::vector<uint32_t> live_;
+    std::vector<uint32_t> live_at_;
+    std::vector<uint64_t> free_bits_;
+    uint32_t free_head_ = kEndOfList;
+    size_t lowest_free_word_ = 0;
+    uint32_t free_count_ = 0;
+    uint32_t retired_ = 0;
+    DynamicBitset disabled_;
+    uint32_t disabled_count_ = 0;
+    RecyclePolicy policy_;
 };
 
+using EntityManager = BasicEntityManager<>;
+
 }  // namespace acorn
@@ -0,0 +1,200 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace acorn
+{
+// Type-erased handle so a World can swap and copy every channel it owns
+class IEventChannel
+{
+public:
+    virtual ~IEventChannel() = default;
+    virtual void swap() = 0;
+    virtual void clear() noexcept = 0;
+    virtual std::unique_ptr<IEventChannel> clone() const = 0;
+};
+
+// Double-buffered queue of T. Events sent during a tick become readable, as one contiguous
+// span, after the next swap(), and are dropped by the swap after that.
+//
+// send() and send_many() are for single-threaded phases. send_concurrent() may be called from
+// many threads at once: it claims slots in a preallocated slab with one atomic add and only
+// takes a lock once the slab is full. No call may overlap swap(), read() or clear(). A slot is
+// claimed before its event is built there, so the concurrent paths need T to move (and, for
+// batches, copy) without throwing.
+template <typename T>
+class EventChannel final : public IEventChannel
+{
+public:
+    static constexpr size_t kDefaultConcurrentCapacity = 1024;
+
+    explicit EventChannel(size_t concurrent_capacity = kDefaultConcurrentCapacity)
+    {
+        allocate_slab(concurrent_capacity);
+    }
+
+    // Copies both buffers; events sitting in the slab move to the copy's pending buffer
+    EventChannel(const EventChannel& other) : readable_(other.readable_), pending_(other.pending_)
+    {
+        const size_t claimed = other.slab_claimed();
+        pending_.insert(pending_.end(), other.slab_, other.slab_ + claimed);
+        pending_.insert(pending_.end(), other.spill_.begin(), other.spill_.end());
+        allocate_slab(other.slab_capacity_);
+    }
+
+    EventChannel& operator=(const EventChannel&) = delete;
+
+    ~EventChannel() override
+    {
+        destroy_slab_contents();
+        std::allocator<T>().deallocate(slab_, slab_capacity_);
+    }
+
+    void send(const T& event)
+    {
+        pending_.push_back(event);
+    }
+
+    void send(T&& event)
+    {
+        pending_.push_back(std::move(event));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        pending_.emplace_back(std::forward<Args>(args)...);
+    }
+
+    void send_many(std::span<const T> events)
+    {
+        pending_.insert(pending_.end(), events.begin(), events.end());
+    }
+
+    // Thread-safe append
+    void send_concurrent(T event)
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "acorn::EventChannel: send_concurrent needs a nothrow-movable event");
+        const size_t i = slab_cursor_.fetch_add(1, std::memory_order_relaxed);
+        if (i < slab_capacity_)
+        {
+            std::construct_at(slab_ + i, std::move(event));
+            return;
+        }
+
+        std::lock_guard lock(spill_mutex_);
+        spill_.push_back(std::move(event));
+    }
+
+    // Thread-safe batch append: one atomic add claims the whole range
+    void send_many_concurrent(std::span<const T> events)
+    {
+        static_assert(std::is_nothrow_copy_constructible_v<T>,
+                      "acorn::EventChannel: send_many_concurrent needs a nothrow-copyable event");
+        const size_t first = slab_cursor_.fetch_add(events.size(), std::memory_order_relaxed);
+        const size_t fitting = first < slab_capacity_ ? std::min(events.size(),
+                                                                 slab_capacity_ - first)
+                                                      : 0;
+        if (fitting > 0)
+            std::uninitialized_copy_n(events.begin(), fitting, slab_ + first);
+
+        if (fitting < events.size())
+        {
+            std::lock_guard lock(spill_mutex_);
+            spill_.insert(spill_.end(), events.begin() + fitting, events.end());
+        }
+    }
+
+    // Events published by the last swap()
+    std::span<const T> read() const noexcept
+    {
+        return readable_;
+    }
+
+    // Publishes everything sent since the previous swap and drops what was readable. When the
+    // slab overflowed, it is regrown to the peak so the next tick stays lock-free.
+    void swap() override
+    {
+        const size_t claimed = slab_claimed();
+        pending_.insert(pending_.end(), std::make_move_iterator(slab_),
+                        std::make_move_iterator(slab_ + claimed));
+        destroy_slab_contents();
+
+        if (!spill_.empty())
+        {
+            pending_.insert(pending_.end(), std::make_move_iterator(spill_.begin()),
+                            std::make_move_iterator(spill_.end()));
+            const size_t peak = slab_capacity_ + spill_.size();
+            spill_.clear();
+
+            T* old_slab = slab_;
+            const size_t old_capacity = slab_capacity_;
+            allocate_slab(std::bit_ceil(peak));
+            std::allocator<T>().deallocate(old_slab, old_capacity);
+        }
+
+        readable_.clear();
+        readable_.swap(pending_);
+    }
+
+    void clear() noexcept override
+    {
+        destroy_slab_contents();
+        spill_.clear();
+        pending_.clear();
+        readable_.clear();
+    }
+
+    std::unique_ptr<IEventChannel> clone() const override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+            return std::make_unique<EventChannel>(*this);
+        else
+            throw std::logic_error("acorn::EventChannel: cannot clone a non-copyable event");
+    }
+
+private:
+    size_t slab_claimed() const noexcept
+    {
+        return std::min(slab_cursor_.load(std::memory_order_relaxed), slab_capacity_);
+    }
+
+    // Commits only once the allocation succeeded, so a throw keeps the old slab and its size
+    // matching for the deallocate that eventually frees it
+    void allocate_slab(size_t capacity)
+    {
+        capacity = std::max<size_t>(capacity, 1);
+        T* slab = std::allocator<T>().allocate(capacity);
+        slab_ = slab;
+        slab_capacity_ = capacity;
+        slab_cursor_.store(0, std::memory_order_relaxed);
+    }
+
+    void destroy_slab_contents() noexcept
+    {
+        std::destroy_n(slab_, slab_claimed());
+        slab_cursor_.store(0, std::memory_order_relaxed);
+    }
+
+    std::vector<T> readable_;
+    std::vector<T> pending_;
+
+    // Concurrent appends: raw storage claimed through slab_cursor_, overflow in spill_
+    T* slab_ = nullptr;
+    size_t slab_capacity_ = 0;
+    std::atomic<size_t> slab_cursor_{0};
+    std::mutex spill_mutex_;
+    std::vector<T> spill_;
+};
+}  // namespace acorn
@@ -1,4 +1,9 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#include "dynamic_bitset.hpp"
 #include "view.hpp"
 
 namespace acorn
@@ -16,28 +21,20 @@ template <typename... Include, typename... Exclude>
 class ExcludeView<std::tuple<Include...>, std::tuple<Exclude...>>
 {
 public:
+    using entity_type = typename View<Include...>::entity_type;
+
+    // the include side is a plain View, so lead selection and the unchecked lookups are shared
     ExcludeView(std::tuple<Include&...> include, std::tuple<Exclude&...> exclude)
-        : include_(include), exclude_(exclude)
+        : include_(std::make_from_tuple<View<Include...>>(include)), exclude_(exclude)
     {
-        // pick smallest include pool as the lead — same logic as View
-        size_t min_size = std::numeric_limits<size_t>::max();
-        auto find_smallest = [&](auto& pool)
-        {
-            if (pool.size() < min_size)
-            {
-                min_size = pool.size();
-                lead_entities_ = &pool.entities();
-            }
-        };
-        std::apply([&](auto&... pools) { (find_smallest(pools), ...); }, include_);
     }
 
-    bool contains_all(Entity e) const
+    bool contains_all(entity_type e) const
     {
-        return std::apply([e](auto&... pools) { return (pools.has(e) && ...); }, include_);
+        return include_.contains_all(e);
     }
 
-    bool contains_any_excluded(Entity e) const
+    bool contains_any_excluded(entity_type e) const
     {
         return std::apply([e](auto&... pools) { return (pools.has(e) || ...); }, exclude_);
     }
@@ -45,22 +42,61 @@ public:
     template <typename Func>
     void each(Func&& f) const
     {
-        if (!lead_entities_)
-            return;
+        include_.each_where([this](entity_type e) { return !excluded(e); }, f);
+    }
+
+    // View::each_safe() with the same guarantees; f may also add excluded components to the
+    // current entity
+    template <typename Func>
+    void each_safe(Func&& f) const
+    {
+        include_.each_safe_where([this](entity_type e) { return !excluded(e); }, f);
+    }
 
-        for (Entity e : *lead_entities_)
+    // View::each_present() with the excluded pools' bitsets removed word by word. Every pool,
+    // included or excluded, must track presence.
+    template <typename Func>
+    void each_present(Func&& f) const
+    {
+        const auto excluded = std::apply(
+            [](auto&... pools)
+            { return std::array<const DynamicBitset*, sizeof...(Exclude)>{pools.presence()...}; },
+            exclude_);
+        for (const DynamicBitset* set : excluded)
         {
-            if (contains_all(e) && !contains_any_excluded(e))
-            {
-                std::apply([&](auto&... pools) { f(e, pools.get(e)...); }, include_);
-            }
+            if (set == nullptr)
+                throw std::logic_error(
+                    "acorn::ExcludeView: each_present needs presence tracking on every pool");
         }
+
+        include_.each_present_except(
+            [&](size_t w)
+            {
+                uint64_t bits = 0;
+                for (const DynamicBitset* set : excluded)
+                {
+                    bits |= set->word(w);
+                }
+                return bits;
+            },
+            f);
     }
 
 private:
-    std::tuple<Include&...> include_;
+    // Entities reaching the filter are known to be alive, so a sparse read is enough
+    bool excluded(entity_type e) const noexcept
+    {
+        return std::apply(
+            [e](auto&... pools)
+            {
+                return ((pools.position(e) != std::remove_cvref_t<decltype(pools)>::kAbsent) ||
+                        ...);
+            },
+            exclude_);
+    }
+
+    View<Include...> include_;
     std::tuple<Exclude&...> exclude_;
-    const std::vector<Entity>* lead_entities_ = nullptr;
 };
 
-}  // namespace acorn
\ No newline at end of file
+}  // namespace acorn
@@ -0,0 +1,390 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "acorn_assert.hpp"
+#include "component_pool.hpp"
+#include "entity.hpp"
+#include "entity_manager.hpp"
+
+namespace acorn
+{
+// Parent/child relationships stored level by level: every entity sits in the array of its
+// depth, so walking the levels in order visits parents before their children in a handful of
+// linear passes. sort() additionally groups siblings and orders each level like the one above
+// it, and flattens the result into order(): hand that to ComponentPool::sort_as() and a
+// transform pass becomes one linear walk over the pools, reading each parent by position.
+//
+// World::hierarchy() is told about destroyed entities. A standalone hierarchy, like a
+// standalone ComponentPool, is not: remove entities from it before destroying them.
+template <typename Traits = DefaultEntityTraits>
+class BasicHierarchy
+{
+public:
+    using entity_type = BasicEntity<Traits>;
+    using entity_manager_type = BasicEntityManager<Traits>;
+
+    // parent_positions() entry of a root
+    static constexpr uint32_t kNoParent = UINT32_MAX;
+
+    explicit BasicHierarchy(const entity_manager_type& em) : nodes_(em) {}
+
+    // Copies `other`, bound to `em`, which must hold the same entities
+    BasicHierarchy(const entity_manager_type& em, const BasicHierarchy& other)
+        : nodes_(em, other.nodes_),
+          levels_(other.levels_),
+          order_(other.order_),
+          parent_at_(other.parent_at_)
+    {
+    }
+
+    bool has(entity_type e) const noexcept
+    {
+        return nodes_.has(e);
+    }
+
+    size_t size() const noexcept
+    {
+        return nodes_.size();
+    }
+
+    // Number of depth levels in use, roots being level 0
+    size_t depth_count() const noexcept
+    {
+        return levels_.size();
+    }
+
+    entity_type parent(entity_type e) const
+    {
+        return checked_node(e).parent;
+    }
+
+    uint32_t depth(entity_type e) const
+    {
+        return checked_node(e).depth;
+    }
+
+    // Makes `child` a child of `parent`, or a root when `parent` is null. Either entity is
+    // added if it is not in the hierarchy yet. Moving an existing child costs O(depth) for
+    // the cycle check plus O(1) per entity of its subtree.
+    void attach(entity_type child, entity_type parent = entity_type::null())
+    {
+        uint32_t depth = 0;
+        if (!parent.is_null())
+        {
+            if (!has(parent))
+                attach(parent);
+
+            for (entity_type p = parent; !p.is_null(); p = node(p).parent)
+            {
+                if (p == child)
+                    throw std::invalid_argument(
+                        "acorn::Hierarchy: cannot attach an entity below itself");
+            }
+            depth = node(parent).depth + 1;
+        }
+
+        if (!has(child))
+        {
+            drop_order();
+            nodes_.emplace(child, Node{.parent = parent});
+            place(child, depth);
+            link(child, parent);
+        }
+        else if (node(child).parent != parent)
+        {
+            drop_order();
+            unlink(child);
+
+            Node& n = node(child);
+            n.parent = parent;
+            levels_[n.depth][n.slot].parent = parent;
+            link(child, parent);
+
+            if (n.depth != depth)
+                shift_subtree(child, static_cast<int64_t>(depth) - n.depth);
+        }
+
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
+    }
+
+    // Removes `e`; its children move up to e's parent, taking their subtrees with them
+    bool remove(entity_type e)
+    {
+        if (!has(e))
+            return false;
+
+        const entity_type parent = node(e).parent;
+        for (entity_type c = node(e).first_child; !c.is_null();)
+        {
+            const entity_type next = node(c).next_sibling;
+            attach(c, parent);
+            c = next;
+        }
+
+        drop_order();
+        unlink(e);
+        unplace(e);
+        nodes_.remove(e);
+
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        nodes_.clear();
+        for (auto& level : levels_)
+        {
+            level.clear();
+        }
+        drop_order();
+    }
+
+    // Calls f(entity, parent) for every entity, parents strictly before their children.
+    // Roots get a null parent.
+    template <typename Func>
+    void each(Func&& f) const
+    {
+        for (const auto& level : levels_)
+        {
+            for (const Link& link : level)
+            {
+                f(link.entity, link.parent);
+            }
+        }
+    }
+
+    template <typename Func>
+    void each_child(entity_type e, Func&& f) const
+    {
+        for (entity_type c = checked_node(e).first_child; !c.is_null(); c = node(c).next_sibling)
+        {
+            f(c);
+        }
+    }
+
+    // Every entity as of the last sort(), parents first and each parent's children in one
+    // contiguous run. Emptied by the next attach(), remove() or clear().
+    std::span<const entity_type> order() const noexcept
+    {
+        return order_;
+    }
+
+    // For each position of order(), the position of its parent there, or kNoParent
+    std::span<const uint32_t> parent_positions() const noexcept
+    {
+        return parent_at_;
+    }
+
+    // Reorders every level to follow the level above it, so the children of one parent sit
+    // next to each other and in their parent's order, and rebuilds order(). O(size()).
+    void sort()
+    {
+        while (!levels_.empty() && levels_.back().empty())
+        {
+            levels_.pop_back();
+        }
+
+        drop_order();
+        order_.reserve(nodes_.size());
+        parent_at_.reserve(nodes_.size());
+        if (!levels_.empty())
+        {
+            for (const Link& root : levels_[0])
+            {
+                order_.push_back(root.entity);
+                parent_at_.push_back(kNoParent);
+            }
+        }
+
+        // Position in order_ of the first entity of level d - 1
+        size_t above = 0;
+        for (size_t d = 1; d < levels_.size(); ++d)
+        {
+            const size_t begin = order_.size();
+            scratch_.clear();
+            for (size_t j = 0; j < levels_[d - 1].size(); ++j)
+            {
+                const entity_type p = levels_[d - 1][j].entity;
+                for (entity_type c = node(p).first_child; !c.is_null(); c = node(c).next_sibling)
+                {
+                    scratch_.push_back(Link{c, p});
+                    order_.push_back(c);
+                    parent_at_.push_back(static_cast<uint32_t>(above + j));
+                }
+            }
+            above = begin;
+
+            ACORN_ASSERT(scratch_.size() == levels_[d].size());
+            levels_[d].swap(scratch_);
+            for (uint32_t i = 0; i < levels_[d].size(); ++i)
+            {
+                node(levels_[d][i].entity).slot = i;
+            }
+        }
+
+#ifndef NDEBUG
+        debug_check_invariants();
+#endif
+    }
+
+private:
+    struct Node
+    {
+        entity_type parent{};
+        entity_type first_child{};
+        entity_type prev_sibling{};
+        entity_type next_sibling{};
+        uint32_t depth = 0;
+        uint32_t slot = 0;
+    };
+
+    struct Link
+    {
+        entity_type entity;
+        entity_type parent;
+    };
+
+    void drop_order() noexcept
+    {
+        order_.clear();
+        parent_at_.clear();
+    }
+
+    // Entities handed to these are known to be in the hierarchy, so the sparse read is enough
+    Node& node(entity_type e) noexcept
+    {
+        return nodes_.data_at(nodes_.position(e));
+    }
+
+    const Node& node(entity_type e) const noexcept
+    {
+        return nodes_.data_at(nodes_.position(e));
+    }
+
+    const Node& checked_node(entity_type e) const
+    {
+        if (!has(e))
+            throw std::out_of_range("acorn::Hierarchy: entity is not in the hierarchy");
+        return node(e);
+    }
+
+    void place(entity_type e, uint32_t depth)
+    {
+        if (depth >= levels_.size())
+            levels_.resize(depth + 1);
+
+        Node& n = node(e);
+        n.depth = depth;
+        n.slot = static_cast<uint32_t>(levels_[depth].size());
+        levels_[depth].push_back(Link{e, n.parent});
+    }
+
+    // Swap-and-pop out of its level
+    void unplace(entity_type e) noexcept
+    {
+        const Node& n = node(e);
+        auto& level = levels_[n.depth];
+
+        if (n.slot + 1 != level.size())
+        {
+            level[n.slot] = level.back();
+            node(level[n.slot].entity).slot = n.slot;
+        }
+        level.pop_back();
+    }
+
+    void link(entity_type e, entity_type parent) noexcept
+    {
+        if (parent.is_null())
+            return;
+
+        Node& p = node(parent);
+        Node& n = node(e);
+        n.prev_sibling = entity_type::null();
+        n.next_sibling = p.first_child;
+        if (!p.first_child.is_null())
+            node(p.first_child).prev_sibling = e;
+        p.first_child = e;
+    }
+
+    void unlink(entity_type e) noexcept
+    {
+        Node& n = node(e);
+        if (!n.prev_sibling.is_null())
+            node(n.prev_sibling).next_sibling = n.next_sibling;
+        else if (!n.parent.is_null())
+            node(n.parent).first_child = n.next_sibling;
+
+        if (!n.next_sibling.is_null())
+            node(n.next_sibling).prev_sibling = n.prev_sibling;
+
+        n.prev_sibling = entity_type::null();
+        n.next_sibling = entity_type::null();
+    }
+
+    // Moves every entity of root's subtree `delta` levels, walking the sibling links
+    // depth-first without a stack
+    void shift_subtree(entity_type root, int64_t delta)
+    {
+        entity_type e = root;
+        while (true)
+        {
+            const auto depth = static_cast<uint32_t>(node(e).depth + delta);
+            unplace(e);
+            place(e, depth);
+
+            if (!node(e).first_child.is_null())
+            {
+                e = node(e).first_child;
+                continue;
+            }
+            while (e != root && node(e).next_sibling.is_null())
+            {
+                e = node(e).parent;
+            }
+            if (e == root)
+                return;
+            e = node(e).next_sibling;
+        }
+    }
+
+#ifndef NDEBUG
+    void debug_check_invariants() const
+    {
+        size_t total = 0;
+        for (size_t d = 0; d < levels_.size(); ++d)
+        {
+            for (size_t i = 0; i < levels_[d].size(); ++i)
+            {
+                const Link& link = levels_[d][i];
+                const Node& n = node(link.entity);
+
+                ACORN_ASSERT(n.depth == d && n.slot == i);
+                ACORN_ASSERT(n.parent == link.parent);
+                ACORN_ASSERT(n.parent.is_null() ? d == 0 : node(n.parent).depth + 1 == d);
+            }
+            total += levels_[d].size();
+        }
+        ACORN_ASSERT(total == nodes_.size());
+    }
+#endif
+
+    ComponentPool<Node, Traits> nodes_;
+    std::vector<std::vector<Link>> levels_;
+    std::vector<Link> scratch_;
+    // Flattened levels as of the last sort()
+    std::vector<entity_type> order_;
+    std::vector<uint32_t> parent_at_;
+};
+
+using Hierarchy = BasicHierarchy<>;
+
+}  // namespace acorn
@@ -0,0 +1,359 @@
+#pragma once
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "acorn_assert.hpp"
+#include "pool_storage.hpp"
+
+namespace acorn
+{
+// std::vector-like array of trivially copyable U living in a file-backed shared mapping.
+// The element count is kept in a header inside the mapping, so the array survives the process
+// and reopening the file restores it as is, with no deserialization. Growing extends the file
+// and remaps; like a vector, that invalidates pointers into the array. POSIX only.
+template <typename U>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable_v<U>, "mapped elements are stored as raw bytes");
+
+    struct Header
+    {
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t size;
+    };
+
+    static constexpr uint64_t kMagic = 0x61636f726e6d6170;  // "acornmap"
+    static constexpr size_t kHeaderBytes = 64;
+    static constexpr size_t kMinCapacity = 1024;
+
+    static_assert(alignof(U) <= kHeaderBytes);
+
+public:
+    using value_type = U;
+    using size_type = size_t;
+    using iterator = U*;
+    using const_iterator = const U*;
+
+    explicit MappedVector(const std::filesystem::path& path,
+                          AccessHint hint = AccessHint::Sequential)
+        : hint_(hint)
+    {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0)
+            throw_errno("open " + path.string());
+
+        // The destructor does not run for a constructor that throws
+        try
+        {
+            open_mapping(path);
+        }
+        catch (...)
+        {
+            unmap_and_close();
+            throw;
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    ~MappedVector()
+    {
+        unmap_and_close();
+    }
+
+    size_t size() const noexcept
+    {
+        return header()->size;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return (mapped_bytes_ - kHeaderBytes) / sizeof(U);
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    U* data() noexcept
+    {
+        return reinterpret_cast<U*>(base_ + kHeaderBytes);
+    }
+
+    const U* data() const noexcept
+    {
+        return reinterpret_cast<const U*>(base_ + kHeaderBytes);
+    }
+
+    U& operator[](size_t i) noexcept
+    {
+        return data()[i];
+    }
+
+    const U& operator[](size_t i) const noexcept
+    {
+        return data()[i];
+    }
+
+    U& back() noexcept
+    {
+        return data()[size() - 1];
+    }
+
+    const U& back() const noexcept
+    {
+        return data()[size() - 1];
+    }
+
+    iterator begin() noexcept
+    {
+        return data();
+    }
+
+    iterator end() noexcept
+    {
+        return data() + size();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data() + size();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    void reserve(size_t n)
+    {
+        if (n > capacity())
+            remap(kHeaderBytes + n * sizeof(U));
+    }
+
+    template <typename... Args>
+    U& emplace_back(Args&&... args)
+    {
+        grow_for(size() + 1);
+        U* slot = std::construct_at(data() + size(), std::forward<Args>(args)...);
+        ++header()->size;
+        return *slot;
+    }
+
+    void push_back(const U& value)
+    {
+        emplace_back(value);
+    }
+
+    void pop_back() noexcept
+    {
+        ACORN_ASSERT(!empty());
+        --header()->size;
+    }
+
+    void clear() noexcept
+    {
+        header()->size = 0;
+    }
+
+    void resize(size_t n, const U& value = U{})
+    {
+        grow_for(n);
+        if (n > size())
+            std::uninitialized_fill(data() + size(), data() + n, value);
+        header()->size = n;
+    }
+
+    // Appends only: `pos` must be end()
+    template <typename InputIt>
+    void insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        ACORN_ASSERT(pos == cend());
+        (void)pos;
+
+        const auto count = static_cast<size_t>(std::distance(first, last));
+        grow_for(size() + count);
+        std::uninitialized_copy(first, last, data() + size());
+        header()->size += count;
+    }
+
+    void insert(const_iterator pos, size_t count, const U& value)
+    {
+        ACORN_ASSERT(pos == cend());
+        (void)pos;
+
+        grow_for(size() + count);
+        std::uninitialized_fill_n(data() + size(), count, value);
+        header()->size += count;
+    }
+
+    // Writes dirty pages back to the file now rather than whenever the kernel chooses
+    void flush()
+    {
+        if (::msync(base_, mapped_bytes_, MS_SYNC) != 0)
+            throw_errno("msync");
+    }
+
+private:
+    [[noreturn]] static void throw_errno(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), "acorn::MappedVector: " + what);
+    }
+
+    Header* header() noexcept
+    {
+        return reinterpret_cast<Header*>(base_);
+    }
+
+    const Header* header() const noexcept
+    {
+        return reinterpret_cast<const Header*>(base_);
+    }
+
+    // Maps a new file with an empty header, or an existing one after checking its header
+    void open_mapping(const std::filesystem::path& path)
+    {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0)
+            throw_errno("fstat");
+
+        const auto file_bytes = static_cast<size_t>(st.st_size);
+        if (file_bytes == 0)
+        {
+            map(kHeaderBytes + kMinCapacity * sizeof(U));
+            *header() = Header{kMagic, sizeof(U), 0};
+            return;
+        }
+
+        if (file_bytes < kHeaderBytes)
+            throw std::runtime_error("acorn::MappedVector: " + path.string() + " is truncated");
+
+        map(file_bytes);
+        if (header()->magic != kMagic || header()->element_size != sizeof(U))
+            throw std::runtime_error("acorn::MappedVector: " + path.string() +
+                                     " does not hold this element type");
+        if (header()->size > capacity())
+            throw std::runtime_error("acorn::MappedVector: " + path.string() +
+                                     " records more elements than it holds");
+    }
+
+    void grow_for(size_t n)
+    {
+        if (n > capacity())
+            remap(kHeaderBytes + std::max(n, capacity() * 2) * sizeof(U));
+    }
+
+    void map(size_t bytes)
+    {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+            throw_errno("ftruncate");
+
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED)
+            throw_errno("mmap");
+
+        base_ = static_cast<std::byte*>(p);
+        mapped_bytes_ = bytes;
+        advise();
+    }
+
+    void remap(size_t bytes)
+    {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+            throw_errno("ftruncate");
+
+#ifdef MREMAP_MAYMOVE
+        void* p = ::mremap(base_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+            throw_errno("mremap");
+        base_ = static_cast<std::byte*>(p);
+        mapped_bytes_ = bytes;
+        advise();
+#else
+        ::munmap(base_, mapped_bytes_);
+        base_ = nullptr;
+        map(bytes);
+#endif
+    }
+
+    // Dense arrays are read front to back by views, so the kernel may read ahead aggressively;
+    // sparse arrays are probed at random, where read-ahead only wastes the page cache
+    void advise() noexcept
+    {
+        ::madvise(base_, mapped_bytes_,
+                  hint_ == AccessHint::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    }
+
+    void unmap_and_close() noexcept
+    {
+        if (base_)
+            ::munmap(base_, mapped_bytes_);
+        if (fd_ >= 0)
+            ::close(fd_);
+        base_ = nullptr;
+        fd_ = -1;
+    }
+
+    int fd_ = -1;
+    std::byte* base_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    AccessHint hint_;
+};
+
+// Storage policy placing every array of a pool in its own file under `directory`. Opening a
+// pool on a directory that already holds its files picks up where the last run stopped; see
+// BasicEntityManager::restore() for bringing the entities back to life.
+class MappedStorage
+{
+public:
+    template <typename U>
+    using array = MappedVector<U>;
+
+    explicit MappedStorage(std::filesystem::path directory) : directory_(std::move(directory))
+    {
+        std::filesystem::create_directories(directory_);
+    }
+
+    template <typename U>
+    array<U> make(std::string_view name, AccessHint hint) const
+    {
+        return array<U>(directory_ / (std::string(name) + ".bin"), hint);
+    }
+
+    const std::filesystem::path& directory() const noexcept
+    {
+        return directory_;
+    }
+
+private:
+    std::filesystem::path directory_;
+};
+}  // namespace acorn
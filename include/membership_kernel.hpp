@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Batched sparse-set membership: resolves a block of entity indices against one pool's sparse
+// array at a time. x86-64 builds with GCC or Clang get AVX2 and AVX-512 kernels compiled through
+// target attributes and picked at runtime, so no -mavx flags are needed; everything else uses
+// the scalar kernel.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    #define ACORN_MEMBERSHIP_X86 1
+    #include <immintrin.h>
+#else
+    #define ACORN_MEMBERSHIP_X86 0
+#endif
+
+namespace acorn::detail
+{
+// Lanes per block. One AVX-512 gather, or two AVX2 ones.
+inline constexpr size_t kMembershipBlock = 16;
+
+inline constexpr uint32_t kMembershipAbsent = UINT32_MAX;
+
+// Writes out[k] = sparse[indices[k]], or kMembershipAbsent past the end of `sparse`, for the
+// kMembershipBlock lanes and returns the mask of lanes that hold a position
+using MembershipKernel = uint32_t (*)(const uint32_t* indices, const uint32_t* sparse,
+                                      size_t sparse_size, uint32_t* out) noexcept;
+
+inline uint32_t membership_scalar(const uint32_t* indices, const uint32_t* sparse,
+                                  size_t sparse_size, uint32_t* out) noexcept
+{
+    uint32_t mask = 0;
+    for (size_t k = 0; k < kMembershipBlock; ++k)
+    {
+        out[k] = indices[k] < sparse_size ? sparse[indices[k]] : kMembershipAbsent;
+        mask |= uint32_t{out[k] != kMembershipAbsent} << k;
+    }
+    return mask;
+}
+
+#if ACORN_MEMBERSHIP_X86
+// The gathers take signed 32-bit offsets, which is why the dispatcher keeps sparse arrays of
+// 2^31 slots or more on the scalar kernel
+__attribute__((target("avx2"))) inline uint32_t membership_avx2(const uint32_t* indices,
+                                                                const uint32_t* sparse,
+                                                                size_t sparse_size,
+                                                                uint32_t* out) noexcept
+{
+    if (sparse_size == 0)
+        return membership_scalar(indices, sparse, sparse_size, out);
+
+    const __m256i last = _mm256_set1_epi32(static_cast<int>(sparse_size - 1));
+    const __m256i absent = _mm256_set1_epi32(-1);
+    uint32_t mask = 0;
+
+    for (size_t half = 0; half < kMembershipBlock; half += 8)
+    {
+        const __m256i idx =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + half));
+        // idx <= last, unsigned
+        const __m256i in_range = _mm256_cmpeq_epi32(_mm256_min_epu32(idx, last), idx);
+        const __m256i pos = _mm256_mask_i32gather_epi32(
+            absent, reinterpret_cast<const int*>(sparse), idx, in_range, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + half), pos);
+
+        const __m256i missing = _mm256_cmpeq_epi32(pos, absent);
+        const auto lanes = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(missing)));
+        mask |= (~lanes & 0xFFu) << half;
+    }
+    return mask;
+}
+
+__attribute__((target("avx512f"))) inline uint32_t membership_avx512(const uint32_t* indices,
+                                                                    const uint32_t* sparse,
+                                                                    size_t sparse_size,
+                                                                    uint32_t* out) noexcept
+{
+    const __m512i idx = _mm512_loadu_si512(indices);
+    const __mmask16 in_range =
+        _mm512_cmplt_epu32_mask(idx, _mm512_set1_epi32(static_cast<int>(sparse_size)));
+    const __m512i absent = _mm512_set1_epi32(-1);
+    const __m512i pos = _mm512_mask_i32gather_epi32(absent, in_range, idx, sparse, 4);
+    _mm512_storeu_si512(out, pos);
+
+    return static_cast<uint32_t>(_mm512_cmpneq_epi32_mask(pos, absent));
+}
+#endif
+
+// Best kernel the running CPU supports, picked on first use
+inline MembershipKernel membership_kernel() noexcept
+{
+#if ACORN_MEMBERSHIP_X86
+    static const MembershipKernel kernel = []() -> MembershipKernel
+    {
+        if (__builtin_cpu_supports("avx512f"))
+            return membership_avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return membership_avx2;
+        return membership_scalar;
+    }();
+    return kernel;
+#else
+    return membership_scalar;
+#endif
+}
+
+// Kernel for a sparse array of `sparse_size` slots
+inline MembershipKernel membership_kernel(size_t sparse_size) noexcept
+{
+    return sparse_size < (size_t{1} << 31) ? membership_kernel() : membership_scalar;
+}
+}  // namespace acorn::detail
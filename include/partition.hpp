@@ -0,0 +1,576 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "world.hpp"
+
+namespace acorn
+{
+using CellId = uint32_t;
+
+// Maps the entity handles saved in a cell blob to the entities created for them on load.
+// Handles that were not part of the blob pass through unchanged.
+class EntityRemap
+{
+public:
+    Entity operator()(Entity saved) const
+    {
+        auto it = map_.find(key(saved));
+        return it == map_.end() ? saved : it->second;
+    }
+
+private:
+    friend class Partition;
+
+    static uint64_t key(Entity e) noexcept
+    {
+        return uint64_t{e.index} << 32 | e.generation;
+    }
+
+    std::unordered_map<uint64_t, Entity> map_;
+};
+
+// Splits a World's entities into cells that can be saved to a compact blob, unloaded and
+// streamed back in. Entities never assigned to a cell are left alone. Cells start out active;
+// inactive cells stay resident but are skipped by each_active() and is_active().
+//
+// Only components registered with register_component() travel with a cell. Remove entities
+// from the partition before destroying them elsewhere: a dead entry stays in its cell, skipped
+// by save() and each_active(), until the cell is unloaded or its index is assigned again.
+class Partition
+{
+public:
+    explicit Partition(World& world) : world_(world) {}
+
+    // Finishes outstanding streams; I/O errors have nowhere to go here and are dropped
+    ~Partition()
+    {
+        try
+        {
+            wait();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    Partition(const Partition&) = delete;
+    Partition& operator=(const Partition&) = delete;
+
+    // `name` identifies the type inside blobs, so it must stay stable across builds. `remap`
+    // rewrites any entity handles the component holds when a cell is loaded.
+    template <typename T>
+    void register_component(std::string name,
+                            std::function<void(T&, const EntityRemap&)> remap = {})
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "cell blobs store components as bytes");
+
+        Codec codec;
+        codec.name = std::move(name);
+        codec.element_size = sizeof(T);
+        codec.save = [](World& world, std::span<const Entity> entities, Blob& out)
+        {
+            const ComponentPool<T>& pool = world.pool<T>();
+            const size_t count_at = out.size();
+            out.put(uint32_t{0});
+
+            uint32_t count = 0;
+            for (uint32_t local = 0; local < entities.size(); ++local)
+            {
+                if (const T* value = pool.try_get(entities[local]))
+                {
+                    out.put(local);
+                    out.put(*value);
+                    ++count;
+                }
+            }
+            std::memcpy(out.data() + count_at, &count, sizeof(count));
+        };
+        codec.load = [remap = std::move(remap)](World& world, std::span<const Entity> entities,
+                                                Reader& in, uint32_t count,
+                                                const EntityRemap& map)
+        {
+            auto& pool = world.pool<T>();
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const auto local = in.get<uint32_t>();
+                auto value = in.get<T>();
+                if (local >= entities.size())
+                    throw std::runtime_error("acorn::Partition: corrupt cell blob");
+                if (remap)
+                    remap(value, map);
+                pool.emplace(entities[local], value);
+            }
+        };
+        codecs_.push_back(std::move(codec));
+    }
+
+    // Puts `e` in `cell`, moving it out of any previous cell. O(1).
+    void assign(Entity e, CellId cell)
+    {
+        if (e.index >= members_.size())
+            members_.resize(e.index + 1);
+
+        // Also evicts a dead entity left behind at this index, whose slot would go stale
+        Membership& m = members_[e.index];
+        if (!m.entity.is_null())
+        {
+            if (m.entity == e && m.cell == cell)
+                return;
+            unlink(m.entity);
+        }
+
+        auto& entities = cells_[cell].entities;
+        m = Membership{e, cell, static_cast<uint32_t>(entities.size())};
+        entities.push_back(e);
+    }
+
+    bool remove(Entity e)
+    {
+        if (!is_assigned(e))
+            return false;
+        unlink(e);
+        return true;
+    }
+
+    bool is_assigned(Entity e) const noexcept
+    {
+        return e.index < members_.size() && members_[e.index].entity == e;
+    }
+
+    CellId cell_of(Entity e) const
+    {
+        if (!is_assigned(e))
+            throw std::out_of_range("acorn::Partition: entity is not in any cell");
+        return members_[e.index].cell;
+    }
+
+    bool is_loaded(CellId cell) const
+    {
+        return cells_.contains(cell);
+    }
+
+    std::span<const Entity> entities(CellId cell) const
+    {
+        auto it = cells_.find(cell);
+        if (it == cells_.end())
+            return {};
+        return it->second.entities;
+    }
+
+    void set_active(CellId cell, bool active)
+    {
+        cells_[cell].active = active;
+    }
+
+    bool is_cell_active(CellId cell) const
+    {
+        auto it = cells_.find(cell);
+        return it != cells_.end() && it->second.active;
+    }
+
+    // Entities outside any cell count as active. Suitable as a View::each_where() filter.
+    bool is_active(Entity e) const
+    {
+        return !is_assigned(e) || is_cell_active(members_[e.index].cell);
+    }
+
+    // Serialises the live entities of `cell` and their registered components
+    std::vector<std::byte> save(CellId cell) const
+    {
+        std::vector<Entity> live;
+        for (const Entity e : entities(cell))
+        {
+            if (world_.entity_manager().is_alive(e))
+                live.push_back(e);
+        }
+
+        Blob out;
+        out.put(kBlobMagic);
+        out.put(static_cast<uint32_t>(live.size()));
+        for (const Entity e : live)
+        {
+            out.put(e);
+        }
+
+        out.put(static_cast<uint32_t>(codecs_.size()));
+        for (const Codec& codec : codecs_)
+        {
+            out.put(static_cast<uint32_t>(codec.name.size()));
+            out.put_bytes(codec.name.data(), codec.name.size());
+            out.put(static_cast<uint32_t>(codec.element_size));
+            codec.save(world_, live, out);
+        }
+        return std::move(out.bytes);
+    }
+
+    // Destroys every entity of `cell` and forgets the cell. O(cell size): the entities go
+    // through World::destroy_many(), which touches each pool once.
+    size_t unload(CellId cell)
+    {
+        auto it = cells_.find(cell);
+        if (it == cells_.end())
+            return 0;
+
+        for (const Entity e : it->second.entities)
+        {
+            if (members_[e.index].entity == e)
+                members_[e.index].entity = Entity::null();
+        }
+        const size_t destroyed = world_.destroy_many(it->second.entities);
+        cells_.erase(it);
+        return destroyed;
+    }
+
+    // Recreates the entities of a blob made by save() in `cell` and returns them. Handles the
+    // components held are rewritten through each type's remap function.
+    std::vector<Entity> load(CellId cell, std::span<const std::byte> blob, bool active = true)
+    {
+        Reader in{blob};
+        if (in.get<uint32_t>() != kBlobMagic)
+            throw std::runtime_error("acorn::Partition: not a cell blob");
+
+        const auto entity_count = in.get<uint32_t>();
+        EntityRemap map;
+        std::vector<Entity> created;
+        created.reserve(entity_count);
+        for (uint32_t i = 0; i < entity_count; ++i)
+        {
+            const auto saved = in.get<Entity>();
+            created.push_back(world_.create_entity());
+            map.map_.emplace(EntityRemap::key(saved), created.back());
+        }
+
+        const auto type_count = in.get<uint32_t>();
+        for (uint32_t t = 0; t < type_count; ++t)
+        {
+            std::string name(in.get<uint32_t>(), '\0');
+            in.get_bytes(name.data(), name.size());
+            const auto element_size = in.get<uint32_t>();
+            const auto count = in.get<uint32_t>();
+
+            const Codec* codec = find_codec(name);
+            if (!codec)
+            {
+                // Unknown types are skipped, so blobs outlive components being unregistered
+                in.skip(size_t{count} * (sizeof(uint32_t) + element_size));
+                continue;
+            }
+            if (codec->element_size != element_size)
+                throw std::runtime_error("acorn::Partition: size of '" + name + "' changed");
+            codec->load(world_, created, in, count, map);
+        }
+
+        for (const Entity e : created)
+        {
+            assign(e, cell);
+        }
+        set_active(cell, active);
+        return created;
+    }
+
+    // Saves and unloads `cell` now, and writes the blob to `path` in the background. The blob
+    // is kept until the write has succeeded: should it fail, poll() or wait() loads the cell
+    // back from it before rethrowing, so the entities are not lost (their handles change).
+    void stream_out(CellId cell, std::filesystem::path path)
+    {
+        auto blob = std::make_shared<const std::vector<std::byte>>(save(cell));
+        auto done = std::async(std::launch::async, [blob, path] { write_file(path, *blob); });
+        writes_.push_back(
+            PendingWrite{std::move(path), cell, is_cell_active(cell), blob, std::move(done)});
+        unload(cell);
+    }
+
+    // Reads `path` in the background; poll() or wait() loads it into `cell` once read
+    void stream_in(CellId cell, std::filesystem::path path, bool active = true)
+    {
+        // A write still in flight to the same file must land first
+        for (auto& write : writes_)
+        {
+            if (write.path == path)
+                write.done.wait();
+        }
+        auto blob = std::async(std::launch::async, [path = std::move(path)]
+                               { return read_file(path); });
+        reads_.push_back(PendingRead{cell, active, std::move(blob)});
+    }
+
+    size_t pending_streams() const noexcept
+    {
+        return reads_.size() + writes_.size();
+    }
+
+    // Loads every finished read and retires finished writes without blocking. Returns how
+    // many cells were loaded. Rethrows I/O errors from the background tasks.
+    size_t poll()
+    {
+        return finish(false);
+    }
+
+    // Blocks until every stream has finished, loading cells as their reads complete
+    size_t wait()
+    {
+        return finish(true);
+    }
+
+    // Calls f(entity, components&...) for the enabled entities of active cells that carry every
+    // component. Costs O(entities in active cells), however large inactive cells are.
+    template <typename... Components, typename Func>
+    void each_active(Func&& f)
+    {
+        each_active_in(std::forward_as_tuple(world_.pool<Components>()...), f,
+                       std::index_sequence_for<Components...>{});
+    }
+
+private:
+    static constexpr uint32_t kBlobMagic = 0x4c454341;  // "ACEL"
+
+    struct Blob
+    {
+        std::vector<std::byte> bytes;
+
+        size_t size() const noexcept
+        {
+            return bytes.size();
+        }
+
+        std::byte* data() noexcept
+        {
+            return bytes.data();
+        }
+
+        void put_bytes(const void* p, size_t n)
+        {
+            const auto* b = static_cast<const std::byte*>(p);
+            bytes.insert(bytes.end(), b, b + n);
+        }
+
+        template <typename V>
+        void put(const V& v)
+        {
+            put_bytes(&v, sizeof(V));
+        }
+    };
+
+    struct Reader
+    {
+        std::span<const std::byte> bytes;
+        size_t at = 0;
+
+        void get_bytes(void* p, size_t n)
+        {
+            if (n > bytes.size() - at)
+                throw std::runtime_error("acorn::Partition: truncated cell blob");
+            std::memcpy(p, bytes.data() + at, n);
+            at += n;
+        }
+
+        template <typename V>
+        V get()
+        {
+            V v;
+            get_bytes(&v, sizeof(V));
+            return v;
+        }
+
+        void skip(size_t n)
+        {
+            if (n > bytes.size() - at)
+                throw std::runtime_error("acorn::Partition: truncated cell blob");
+            at += n;
+        }
+    };
+
+    struct Codec
+    {
+        std::string name;
+        size_t element_size = 0;
+        std::function<void(World&, std::span<const Entity>, Blob&)> save;
+        std::function<void(World&, std::span<const Entity>, Reader&, uint32_t, const EntityRemap&)>
+            load;
+    };
+
+    struct Membership
+    {
+        Entity entity;
+        CellId cell = 0;
+        uint32_t slot = 0;
+    };
+
+    struct Cell
+    {
+        std::vector<Entity> entities;
+        bool active = true;
+    };
+
+    struct PendingRead
+    {
+        CellId cell;
+        bool active;
+        std::future<std::vector<std::byte>> blob;
+    };
+
+    struct PendingWrite
+    {
+        std::filesystem::path path;
+        CellId cell;
+        bool active;
+        std::shared_ptr<const std::vector<std::byte>> blob;
+        std::future<void> done;
+    };
+
+    template <typename Pools, typename Func, size_t... Is>
+    void each_active_in(Pools pools, Func& f, std::index_sequence<Is...>)
+    {
+        (std::get<Is>(pools).mark_modified(), ...);
+
+        const auto& em = world_.entity_manager();
+        for (auto& [id, cell] : cells_)
+        {
+            if (!cell.active)
+                continue;
+
+            for (const Entity e : cell.entities)
+            {
+                if (!em.is_enabled(e))
+                    continue;
+
+                // Alive, so a bare sparse read per pool is enough
+                const std::array<uint32_t, sizeof...(Is)> pos{std::get<Is>(pools).position(e)...};
+                if (((pos[Is] == std::remove_cvref_t<decltype(std::get<Is>(pools))>::kAbsent) ||
+                     ...))
+                    continue;
+
+                f(e, std::get<Is>(pools).data_at(pos[Is])...);
+            }
+        }
+    }
+
+    const Codec* find_codec(const std::string& name) const noexcept
+    {
+        for (const Codec& codec : codecs_)
+        {
+            if (codec.name == name)
+                return &codec;
+        }
+        return nullptr;
+    }
+
+    // Swap-and-pop out of its cell's list
+    void unlink(Entity e)
+    {
+        Membership& m = members_[e.index];
+        auto& entities = cells_[m.cell].entities;
+
+        if (m.slot + 1 != entities.size())
+        {
+            entities[m.slot] = entities.back();
+            members_[entities[m.slot].index].slot = m.slot;
+        }
+        entities.pop_back();
+        m.entity = Entity::null();
+    }
+
+    size_t finish(bool block)
+    {
+        std::exception_ptr failed;
+        for (auto it = writes_.begin(); it != writes_.end();)
+        {
+            if (block || ready(it->done))
+            {
+                PendingWrite write = std::move(*it);
+                it = writes_.erase(it);
+                try
+                {
+                    write.done.get();
+                }
+                catch (...)
+                {
+                    // The file may be partial, so the cell comes back from the kept blob
+                    load(write.cell, *write.blob, write.active);
+                    if (!failed)
+                        failed = std::current_exception();
+                }
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        if (failed)
+            std::rethrow_exception(failed);
+
+        size_t loaded = 0;
+        for (auto it = reads_.begin(); it != reads_.end();)
+        {
+            if (block || ready(it->blob))
+            {
+                PendingRead read = std::move(*it);
+                it = reads_.erase(it);
+                load(read.cell, read.blob.get(), read.active);
+                ++loaded;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return loaded;
+    }
+
+    template <typename F>
+    static bool ready(const F& future)
+    {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    static std::vector<std::byte> read_file(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("acorn::Partition: cannot read " + path.string());
+
+        std::vector<char> chars((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+        std::vector<std::byte> bytes(chars.size());
+        std::memcpy(bytes.data(), chars.data(), chars.size());
+        return bytes;
+    }
+
+    static void write_file(const std::filesystem::path& path, const std::vector<std::byte>& blob)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(blob.data()),
+                   static_cast<std::streamsize>(blob.size()));
+        if (!file)
+            throw std::runtime_error("acorn::Partition: cannot write " + path.string());
+    }
+
+    World& world_;
+    std::vector<Codec> codecs_;
+    std::unordered_map<CellId, Cell> cells_;
+    // By entity index
+    std::vector<Membership> members_;
+    std::vector<PendingRead> reads_;
+    std::vector<PendingWrite> writes_;
+};
+}  // namespace acorn
@@ -0,0 +1,28 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+namespace acorn
+{
+// How a pool expects to touch one of its arrays, for storage that can act on it
+enum class AccessHint
+{
+    Sequential,
+    Random,
+};
+
+// Storage policies decide what container backs a ComponentPool's dense and sparse arrays.
+// array<U> must offer the std::vector subset the pool uses, and make<U>(name, hint) builds
+// the array the pool calls `name`.
+struct VectorStorage
+{
+    template <typename U>
+    using array = std::vector<U>;
+
+    template <typename U>
+    array<U> make(std::string_view, AccessHint) const
+    {
+        return {};
+    }
+};
+}  // namespace acorn
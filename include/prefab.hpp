@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "runtime_pool.hpp"
+#include "shared_pool.hpp"
+
+namespace acorn
+{
+class World;
+
+// A component set captured once and stamped onto many entities by World::instantiate(). Each
+// component type costs one pool lookup and one bulk append per instantiate() call, rather than
+// one World::add() per entity.
+class Prefab
+{
+public:
+    // Adds a component to the blueprint, replacing any previous value of the same type
+    template <typename T>
+    Prefab& set(T value)
+    {
+        return add_part(typeid(T),
+                        [value = std::move(value)](auto& world, std::span<const Entity> entities)
+                        { world.template pool<T>().emplace_many(entities, value); });
+    }
+
+    // Adds a shared component: every instance points at one interned copy of `value`.
+    // Query it with has<Shared<T>>().
+    template <typename T>
+    Prefab& share(T value)
+    {
+        return add_part(typeid(Shared<T>),
+                        [value = std::move(value)](auto& world, std::span<const Entity> entities)
+                        { world.template shared<T>().emplace_many(entities, value); });
+    }
+
+    // Adds a runtime component by its World id, replacing any previous bytes for that id.
+    // instantiate() checks the id and the size against the world it stamps into.
+    Prefab& set_runtime(RuntimeComponentId id, std::span<const std::byte> bytes)
+    {
+        for (auto& part : runtime_parts_)
+        {
+            if (part.id == id)
+            {
+                part.bytes.assign(bytes.begin(), bytes.end());
+                return *this;
+            }
+        }
+        runtime_parts_.push_back(RuntimePart{id, {bytes.begin(), bytes.end()}});
+        return *this;
+    }
+
+    bool has_runtime(RuntimeComponentId id) const noexcept
+    {
+        for (const auto& part : runtime_parts_)
+        {
+            if (part.id == id)
+                return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    bool has() const noexcept
+    {
+        const std::type_index type(typeid(T));
+        for (const auto& part : parts_)
+        {
+            if (part.type == type)
+                return true;
+        }
+        return false;
+    }
+
+    size_t size() const noexcept
+    {
+        return parts_.size() + runtime_parts_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return parts_.empty() && runtime_parts_.empty();
+    }
+
+private:
+    friend class World;
+
+    using Stamp = std::function<void(World&, std::span<const Entity>)>;
+
+    struct Part
+    {
+        std::type_index type;
+        Stamp stamp;
+    };
+
+    struct RuntimePart
+    {
+        RuntimeComponentId id;
+        std::vector<std::byte> bytes;
+    };
+
+    Prefab& add_part(std::type_index type, Stamp stamp)
+    {
+        for (auto& part : parts_)
+        {
+            if (part.type == type)
+            {
+                part.stamp = std::move(stamp);
+                return *this;
+            }
+        }
+        parts_.push_back(Part{type, std::move(stamp)});
+        return *this;
+    }
+
+    std::vector<Part> parts_;
+    std::vector<RuntimePart> runtime_parts_;
+};
+}  // namespace acorn
@@ -0,0 +1,367 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "acorn_assert.hpp"
+#include "dynamic_bitset.hpp"
+#include "entity.hpp"
+#include "entity_manager.hpp"
+
+namespace acorn
+{
+// Handle of a component type registered at runtime, e.g. by a scripting layer
+using RuntimeComponentId = uint32_t;
+
+struct RuntimeField
+{
+    std::string name;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+// Shape of a runtime component. The fields are metadata for whoever interprets the bytes;
+// the pool itself only needs the size and alignment.
+struct ComponentLayout
+{
+    std::string name;
+    size_t size = 0;
+    size_t alignment = alignof(std::max_align_t);
+    std::vector<RuntimeField> fields{};
+};
+
+// Sparse set over raw bytes: the same dense/sparse structure as ComponentPool, with each
+// component occupying stride() bytes of one contiguous, suitably aligned buffer. Components
+// are plain bytes, copied and moved with memcpy, and start zeroed unless given initial bytes.
+class RuntimePool
+{
+public:
+    using entity_type = Entity;
+
+    static constexpr uint32_t kAbsent = UINT32_MAX;
+
+    RuntimePool(const EntityManager& em, RuntimeComponentId id, ComponentLayout layout)
+        : em_(em), id_(id), layout_(std::move(layout))
+    {
+        if (layout_.size == 0)
+            throw std::invalid_argument("acorn::RuntimePool: component size must be non-zero");
+        if (!std::has_single_bit(layout_.alignment))
+            throw std::invalid_argument("acorn::RuntimePool: alignment must be a power of two");
+        for (const RuntimeField& field : layout_.fields)
+        {
+            if (field.offset + field.size > layout_.size)
+                throw std::invalid_argument("acorn::RuntimePool: field '" + field.name +
+                                            "' lies outside the component");
+        }
+        stride_ = (layout_.size + layout_.alignment - 1) & ~(layout_.alignment - 1);
+    }
+
+    // Copy bound to another entity manager, e.g. the one of a cloned World
+    RuntimePool(const EntityManager& em, const RuntimePool& other)
+        : em_(em),
+          id_(other.id_),
+          layout_(other.layout_),
+          stride_(other.stride_),
+          dense_entities_(other.dense_entities_),
+          sparse_(other.sparse_)
+    {
+        reserve(other.size());
+        if (!other.empty())
+            std::memcpy(bytes_.get(), other.bytes_.get(), other.size() * stride_);
+    }
+
+    RuntimePool(const RuntimePool&) = delete;
+    RuntimePool& operator=(const RuntimePool&) = delete;
+
+    RuntimeComponentId id() const noexcept
+    {
+        return id_;
+    }
+
+    const EntityManager& entity_manager() const noexcept
+    {
+        return em_;
+    }
+
+    const ComponentLayout& layout() const noexcept
+    {
+        return layout_;
+    }
+
+    // Distance between consecutive components: the size rounded up to the alignment
+    size_t stride() const noexcept
+    {
+        return stride_;
+    }
+
+    size_t size() const noexcept
+    {
+        return dense_entities_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return dense_entities_.empty();
+    }
+
+    bool has(Entity e) const noexcept
+    {
+        if (!em_.is_alive(e))
+            return false;
+
+        const uint32_t pos = position(e);
+        return pos != kAbsent && dense_entities_[pos] == e;
+    }
+
+    std::byte* try_get(Entity e) noexcept
+    {
+        return has(e) ? data_at(sparse_[e.index]) : nullptr;
+    }
+
+    const std::byte* try_get(Entity e) const noexcept
+    {
+        return has(e) ? data_at(sparse_[e.index]) : nullptr;
+    }
+
+    [[nodiscard]] std::span<std::byte> get(Entity e)
+    {
+        if (auto* p = try_get(e))
+            return {p, layout_.size};
+        throw std::out_of_range(
+            "acorn::RuntimePool: entity does not have the requested component");
+    }
+
+    [[nodiscard]] std::span<const std::byte> get(Entity e) const
+    {
+        if (const auto* p = try_get(e))
+            return {p, layout_.size};
+        throw std::out_of_range(
+            "acorn::RuntimePool: entity does not have the requested component");
+    }
+
+    // Same contract as ComponentPool::position: no liveness or generation test
+    uint32_t position(Entity e) const noexcept
+    {
+        return e.index < sparse_.size() ? sparse_[e.index] : kAbsent;
+    }
+
+    std::byte* data_at(size_t pos) noexcept
+    {
+        ACORN_ASSERT(pos < size());
+        return bytes_.get() + pos * stride_;
+    }
+
+    const std::byte* data_at(size_t pos) const noexcept
+    {
+        ACORN_ASSERT(pos < size());
+        return bytes_.get() + pos * stride_;
+    }
+
+    std::span<const Entity> entities() const noexcept
+    {
+        return dense_entities_;
+    }
+
+    // Every component back to back, size() * stride() bytes in entities() order, for batch
+    // processing. Invalidated by the next insertion or removal.
+    std::span<std::byte> bytes() noexcept
+    {
+        return {bytes_.get(), size() * stride_};
+    }
+
+    std::span<const std::byte> bytes() const noexcept
+    {
+        return {bytes_.get(), size() * stride_};
+    }
+
+    // Adds the component, zeroed, or returns the existing one untouched
+    std::span<std::byte> emplace(Entity e)
+    {
+        ACORN_ASSERT(em_.is_alive(e));
+
+        if (has(e))
+            return {data_at(sparse_[e.index]), layout_.size};
+
+        if (e.index >= sparse_.size())
+            sparse_.resize(e.index + 1, kAbsent);
+        reserve(size() + 1);
+
+        const auto pos = static_cast<uint32_t>(size());
+        dense_entities_.push_back(e);
+        sparse_[e.index] = pos;
+
+        std::byte* p = data_at(pos);
+        std::memset(p, 0, stride_);
+        return {p, layout_.size};
+    }
+
+    // Adds or overwrites the component with `init`, which must be exactly layout().size bytes.
+    // `init` may be another component of this pool, e.g. pool.emplace(b, pool.get(a)).
+    std::span<std::byte> emplace(Entity e, std::span<const std::byte> init)
+    {
+        if (init.size() != layout_.size)
+            throw std::invalid_argument("acorn::RuntimePool: initial bytes do not match the size");
+
+        // Growing would free the buffer `init` points into, so grow first and find it again
+        const std::byte* base = bytes_.get();
+        if (std::less_equal<>{}(base, init.data()) &&
+            std::less<>{}(init.data(), base + size() * stride_))
+        {
+            const auto offset = static_cast<size_t>(init.data() - base);
+            reserve(size() + 1);
+            init = {bytes_.get() + offset, init.size()};
+        }
+
+        auto out = emplace(e);
+        std::memmove(out.data(), init.data(), init.size());
+        return out;
+    }
+
+    // Gives each of `entities` a copy of `init`, which must not point into this pool. They must
+    // be alive, distinct and not have the component yet; the buffer grows once for the batch.
+    void emplace_many(std::span<const Entity> entities, std::span<const std::byte> init)
+    {
+        if (init.size() != layout_.size)
+            throw std::invalid_argument("acorn::RuntimePool: initial bytes do not match the size");
+        if (entities.empty())
+            return;
+
+        uint32_t max_index = 0;
+        for (const Entity e : entities)
+        {
+            ACORN_ASSERT(em_.is_alive(e) && position(e) == kAbsent);
+            max_index = std::max(max_index, e.index);
+        }
+        if (max_index >= sparse_.size())
+            sparse_.resize(max_index + 1, kAbsent);
+        reserve(size() + entities.size());
+        dense_entities_.reserve(size() + entities.size());
+
+        for (const Entity e : entities)
+        {
+            const auto pos = static_cast<uint32_t>(size());
+            dense_entities_.push_back(e);
+            sparse_[e.index] = pos;
+
+            std::byte* p = data_at(pos);
+            std::memset(p, 0, stride_);
+            std::memcpy(p, init.data(), init.size());
+        }
+    }
+
+    bool remove(Entity e) noexcept
+    {
+        if (!has(e))
+            return false;
+
+        remove_at(sparse_[e.index]);
+        return true;
+    }
+
+    // See ComponentPool::remove_many
+    size_t remove_many(std::span<const Entity> batch, const DynamicBitset& indices) noexcept
+    {
+        if (empty() || batch.empty())
+            return 0;
+
+        const size_t before = size();
+        if (batch.size() < size())
+        {
+            for (const Entity e : batch)
+            {
+                const uint32_t pos = position(e);
+                if (pos != kAbsent)
+                    remove_at(pos);
+            }
+        }
+        else
+        {
+            for (size_t i = size(); i-- > 0;)
+            {
+                if (indices.test(dense_entities_[i].index))
+                    remove_at(static_cast<uint32_t>(i));
+            }
+        }
+        return before - size();
+    }
+
+    void clear() noexcept
+    {
+        for (const Entity e : dense_entities_)
+        {
+            sparse_[e.index] = kAbsent;
+        }
+        dense_entities_.clear();
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    void reserve(size_t count)
+    {
+        if (count <= capacity_)
+            return;
+
+        const size_t grown = std::max({count, capacity_ * 2, size_t{8}});
+        Bytes bigger(static_cast<std::byte*>(
+                         ::operator new(grown * stride_, std::align_val_t{layout_.alignment})),
+                     AlignedDelete{layout_.alignment});
+        if (bytes_)
+            std::memcpy(bigger.get(), bytes_.get(), size() * stride_);
+
+        bytes_ = std::move(bigger);
+        capacity_ = grown;
+    }
+
+private:
+    struct AlignedDelete
+    {
+        size_t alignment;
+
+        void operator()(std::byte* p) const noexcept
+        {
+            ::operator delete(p, std::align_val_t{alignment});
+        }
+    };
+
+    using Bytes = std::unique_ptr<std::byte[], AlignedDelete>;
+
+    void remove_at(uint32_t pos) noexcept
+    {
+        const Entity e = dense_entities_[pos];
+        const auto last = static_cast<uint32_t>(size() - 1);
+
+        if (pos != last)
+        {
+            const Entity moved = dense_entities_[last];
+            std::memcpy(data_at(pos), data_at(last), stride_);
+            dense_entities_[pos] = moved;
+            sparse_[moved.index] = pos;
+        }
+
+        sparse_[e.index] = kAbsent;
+        dense_entities_.pop_back();
+    }
+
+    const EntityManager& em_;
+    RuntimeComponentId id_;
+    ComponentLayout layout_;
+    size_t stride_ = 0;
+
+    std::vector<Entity> dense_entities_;
+    std::vector<uint32_t> sparse_;
+    Bytes bytes_{nullptr, AlignedDelete{alignof(std::max_align_t)}};
+    size_t capacity_ = 0;
+};
+}  // namespace acorn
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.hpp"
+#include "entity.hpp"
+#include "runtime_pool.hpp"
+
+namespace acorn
+{
+// Query over runtime pools picked at run time: entities with every `include` component and
+// none of the `exclude` ones. As in View, the smallest include pool leads and the others are
+// probed with a bare sparse read. Disabled entities are skipped.
+class RuntimeView
+{
+public:
+    RuntimeView(std::vector<RuntimePool*> include, std::vector<const RuntimePool*> exclude = {})
+        : include_(std::move(include)), exclude_(std::move(exclude))
+    {
+        if (include_.empty())
+            throw std::invalid_argument("acorn::RuntimeView: needs at least one include pool");
+
+        size_t min_size = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < include_.size(); ++i)
+        {
+            if (include_[i]->size() < min_size)
+            {
+                min_size = include_[i]->size();
+                lead_ = i;
+            }
+        }
+    }
+
+    // Calls f(entity, components) where components[i] points at the bytes of include[i]
+    template <typename Func>
+    void each(Func&& f) const
+    {
+        RuntimePool& lead = *include_[lead_];
+        const std::span<const Entity> entities = lead.entities();
+        std::byte* lead_bytes = lead.bytes().data();
+        const size_t stride = lead.stride();
+        std::vector<std::byte*> row(include_.size());
+        const DynamicBitset& disabled = lead.entity_manager().disabled();
+        const bool any_disabled = lead.entity_manager().disabled_count() != 0;
+
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            const Entity e = entities[i];
+            if (resolve(e, row) && !(any_disabled && disabled.test(e.index)))
+            {
+                row[lead_] = lead_bytes + i * stride;
+                f(e, std::span<std::byte* const>(row));
+            }
+        }
+    }
+
+private:
+    // Fills every non-lead slot of `row`; the lead's is known from the iteration position
+    bool resolve(Entity e, std::vector<std::byte*>& row) const
+    {
+        for (size_t p = 0; p < include_.size(); ++p)
+        {
+            if (p == lead_)
+                continue;
+
+            const uint32_t pos = include_[p]->position(e);
+            if (pos == RuntimePool::kAbsent)
+                return false;
+            row[p] = include_[p]->data_at(pos);
+        }
+        for (const RuntimePool* pool : exclude_)
+        {
+            if (pool->position(e) != RuntimePool::kAbsent)
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<RuntimePool*> include_;
+    std::vector<const RuntimePool*> exclude_;
+    size_t lead_ = 0;
+};
+}  // namespace acorn
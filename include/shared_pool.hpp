@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "acorn_assert.hpp"
+#include "component_pool.hpp"
+#include "dynamic_bitset.hpp"
+#include "entity.hpp"
+#include "entity_manager.hpp"
+
+namespace acorn
+{
+// Names the shared storage of T wherever a type key is needed, e.g. Prefab::has<Shared<T>>()
+template <typename T>
+struct Shared
+{
+};
+
+// Interned components: entities holding equal values point at one stored copy, and the
+// entities of each distinct value are kept together so a system can do per-value work once
+// per group. Values are immutable in place; set a new value to change one entity's.
+// T needs operator== and a Hash; the storage of a value is released with its last entity.
+template <typename T, typename Hash = std::hash<T>, typename Traits = DefaultEntityTraits>
+class SharedPool
+{
+public:
+    using value_type = T;
+    using entity_type = BasicEntity<Traits>;
+    using entity_manager_type = BasicEntityManager<Traits>;
+
+    explicit SharedPool(const entity_manager_type& em) : refs_(em) {}
+
+    // Copy bound to a different entity manager, e.g. the one of a cloned World
+    SharedPool(const entity_manager_type& em, const SharedPool& other) : refs_(em)
+    {
+        other.each_group([&](const T& value, std::span<const entity_type> entities)
+                         { emplace_many(entities, value); });
+    }
+
+    SharedPool(const SharedPool&) = delete;
+    SharedPool& operator=(const SharedPool&) = delete;
+
+    bool has(entity_type e) const noexcept
+    {
+        return refs_.has(e);
+    }
+
+    const T* try_get(entity_type e) const noexcept
+    {
+        const Ref* ref = refs_.try_get(e);
+        return ref ? &slots_[ref->slot].value->first : nullptr;
+    }
+
+    [[nodiscard]] const T& get(entity_type e) const
+    {
+        if (const T* p = try_get(e))
+            return *p;
+        throw std::out_of_range(
+            "acorn::SharedPool: entity does not have the requested component");
+    }
+
+    // Points `e` at the interned copy of `value`, storing it on first use
+    const T& emplace(entity_type e, const T& value)
+    {
+        const uint32_t slot = intern(value);
+        if (const Ref* ref = refs_.try_get(e))
+        {
+            if (ref->slot == slot)
+                return value_of(slot);
+            detach(e, *ref);
+        }
+        attach(e, slot);
+        return value_of(slot);
+    }
+
+    // Gives each of `entities` the value, interned once. They must be alive, distinct and not
+    // have the component yet.
+    void emplace_many(std::span<const entity_type> entities, const T& value)
+    {
+        if (entities.empty())
+            return;
+
+        const uint32_t slot = intern(value);
+        slots_[slot].entities.reserve(slots_[slot].entities.size() + entities.size());
+        for (const entity_type e : entities)
+        {
+            ACORN_ASSERT(!refs_.has(e));
+            attach(e, slot);
+        }
+    }
+
+    bool remove(entity_type e) noexcept
+    {
+        const Ref* ref = refs_.try_get(e);
+        if (!ref)
+            return false;
+
+        detach(e, *ref);
+        refs_.remove(e);
+        return true;
+    }
+
+    // See ComponentPool::remove_many
+    size_t remove_many(std::span<const entity_type> batch, const DynamicBitset& indices) noexcept
+    {
+        if (empty() || batch.empty())
+            return 0;
+
+        const size_t before = size();
+        if (batch.size() < size())
+        {
+            for (const entity_type e : batch)
+            {
+                remove(e);
+            }
+        }
+        else
+        {
+            const auto& entities = refs_.entities();
+            for (size_t i = entities.size(); i-- > 0;)
+            {
+                if (indices.test(entities[i].index))
+                    remove(entities[i]);
+            }
+        }
+        return before - size();
+    }
+
+    void clear() noexcept
+    {
+        refs_.clear();
+        slots_.clear();
+        free_slots_.clear();
+        interned_.clear();
+    }
+
+    const entity_manager_type& entity_manager() const noexcept
+    {
+        return refs_.entity_manager();
+    }
+
+    // Entities holding a value
+    size_t size() const noexcept
+    {
+        return refs_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return refs_.empty();
+    }
+
+    // Distinct values currently stored
+    size_t unique_count() const noexcept
+    {
+        return interned_.size();
+    }
+
+    // Calls f(value, entities) once per distinct value. Entity order within a group is
+    // unspecified.
+    template <typename Func>
+    void each_group(Func&& f) const
+    {
+        for (const Slot& slot : slots_)
+        {
+            if (!slot.entities.empty())
+                f(slot.value->first, std::span<const entity_type>(slot.entities));
+        }
+    }
+
+private:
+    using map_type = std::unordered_map<T, uint32_t, Hash>;
+
+    // Where an entity sits: its value's slot and its place in that slot's group
+    struct Ref
+    {
+        uint32_t slot;
+        uint32_t at;
+    };
+
+    // Node iterators of unordered_map survive rehashing, so the value is stored only once
+    struct Slot
+    {
+        typename map_type::iterator value;
+        std::vector<entity_type> entities;
+    };
+
+    const T& value_of(uint32_t slot) const noexcept
+    {
+        return slots_[slot].value->first;
+    }
+
+    uint32_t intern(const T& value)
+    {
+        auto it = interned_.find(value);
+        if (it != interned_.end())
+            return it->second;
+
+        uint32_t slot;
+        if (!free_slots_.empty())
+        {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        else
+        {
+            // Room for every slot to be freed again, so detach never allocates
+            free_slots_.reserve(std::max(slots_.capacity(), slots_.size() + 1));
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        slots_[slot].value = interned_.emplace(value, slot).first;
+        return slot;
+    }
+
+    void attach(entity_type e, uint32_t slot)
+    {
+        auto& group = slots_[slot].entities;
+        refs_.emplace(e, Ref{slot, static_cast<uint32_t>(group.size())});
+        group.push_back(e);
+    }
+
+    // Swap-and-pop out of the group; the value goes once its group is empty. Leaves the Ref
+    // for the caller to overwrite or remove.
+    void detach(entity_type e, Ref ref) noexcept
+    {
+        Slot& slot = slots_[ref.slot];
+        ACORN_ASSERT(slot.entities[ref.at] == e);
+        (void)e;
+
+        if (ref.at + 1 != slot.entities.size())
+        {
+            const entity_type moved = slot.entities.back();
+            slot.entities[ref.at] = moved;
+            refs_.data_at(refs_.position(moved)).at = ref.at;
+        }
+        slot.entities.pop_back();
+
+        if (slot.entities.empty())
+        {
+            interned_.erase(slot.value);
+            slot.value = {};
+            free_slots_.push_back(ref.slot);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    map_type interned_;
+    ComponentPool<Ref, Traits> refs_;
+};
+}  // namespace acorn
@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "component_pool.hpp"
+#include "shared_pool.hpp"
+
+namespace acorn
+{
+// Joins a SharedPool with ordinary pools, one shared value at a time:
+//
+//     view.each_group([](const Mesh& mesh, auto& group) {
+//         bind(mesh);                                   // once per distinct mesh
+//         group.each([](Entity e, Transform& t) { ... });
+//     });
+//
+// group.each() visits the enabled entities holding that value which also have every other
+// component.
+template <typename SharedPoolType, typename... Pools>
+class SharedView
+{
+public:
+    using entity_type = typename SharedPoolType::entity_type;
+
+    static_assert((std::is_same_v<typename std::remove_cv_t<Pools>::entity_type, entity_type> &&
+                   ...),
+                  "all pools of a view must use the same entity handle type");
+
+    class Group
+    {
+    public:
+        size_t size() const noexcept
+        {
+            return entities_.size();
+        }
+
+        // The group's entities, whether or not they have the other components or are enabled
+        std::span<const entity_type> entities() const noexcept
+        {
+            return entities_;
+        }
+
+        template <typename Func>
+        void each(Func&& f) const
+        {
+            constexpr size_t N = sizeof...(Pools);
+            const bool any_disabled = em_.disabled_count() != 0;
+            for (const entity_type e : entities_)
+            {
+                if (any_disabled && em_.disabled().test(e.index))
+                    continue;
+                // Group members are alive, so a present sparse slot is theirs
+                [&]<size_t... Is>(std::index_sequence<Is...>)
+                {
+                    const std::array<uint32_t, N> pos{std::get<Is>(pools_).position(e)...};
+                    if (((pos[Is] != kAbsent) && ...))
+                        f(e, std::get<Is>(pools_).data_at(pos[Is])...);
+                }(std::make_index_sequence<N>{});
+            }
+        }
+
+    private:
+        friend class SharedView;
+
+        Group(std::span<const entity_type> entities, const std::tuple<Pools&...>& pools,
+              const typename SharedPoolType::entity_manager_type& em)
+            : entities_(entities), pools_(pools), em_(em)
+        {
+        }
+
+        std::span<const entity_type> entities_;
+        const std::tuple<Pools&...>& pools_;
+        const typename SharedPoolType::entity_manager_type& em_;
+    };
+
+    SharedView(const SharedPoolType& shared, Pools&... pools) : shared_(shared), pools_(pools...)
+    {
+        static_assert(((std::remove_cv_t<Pools>::kAbsent == kAbsent) && ...));
+    }
+
+    // Calls f(value, group) once per distinct shared value
+    template <typename Func>
+    void each_group(Func&& f) const
+    {
+        mark_modified();
+        shared_.each_group(
+            [&](const auto& value, std::span<const entity_type> entities)
+            {
+                Group group(entities, pools_, shared_.entity_manager());
+                f(value, group);
+            });
+    }
+
+private:
+    static constexpr uint32_t kAbsent = UINT32_MAX;
+
+    // Groups write through data_at(), so a pass bumps the pools held mutably once up front,
+    // as View does
+    void mark_modified() const noexcept
+    {
+        std::apply(
+            [](auto&... pools)
+            {
+                auto bump = [](auto& pool)
+                {
+                    if constexpr (!std::is_const_v<std::remove_reference_t<decltype(pool)>>)
+                        pool.mark_modified();
+                };
+                (bump(pools), ...);
+            },
+            pools_);
+    }
+
+    const SharedPoolType& shared_;
+    std::tuple<Pools&...> pools_;
+};
+}  // namespace acorn
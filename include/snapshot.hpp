@@ -0,0 +1,205 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "component_pool.hpp"
+#include "entity.hpp"
+#include "world.hpp"
+
+namespace acorn
+{
+template <typename... Ts>
+class SnapshotPublisher;
+
+// Immutable copy of one pool as of a publish
+template <typename T>
+class PoolSnapshot
+{
+public:
+    // The pool's version() when it was copied: equal versions mean equal contents
+    uint64_t version() const noexcept
+    {
+        return version_;
+    }
+
+    size_t size() const noexcept
+    {
+        return entities_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return entities_.empty();
+    }
+
+    std::span<const Entity> entities() const noexcept
+    {
+        return entities_;
+    }
+
+    std::span<const T> components() const noexcept
+    {
+        return data_;
+    }
+
+    // The component `e` had at publish time, or nullptr
+    const T* find(Entity e) const noexcept
+    {
+        if (e.index >= sparse_.size())
+            return nullptr;
+
+        const uint32_t pos = sparse_[e.index];
+        if (pos == ComponentPool<T>::kAbsent || entities_[pos] != e)
+            return nullptr;
+        return &data_[pos];
+    }
+
+    template <typename Func>
+    void each(Func&& f) const
+    {
+        for (size_t i = 0; i < entities_.size(); ++i)
+        {
+            f(entities_[i], data_[i]);
+        }
+    }
+
+private:
+    template <typename... Ts>
+    friend class SnapshotPublisher;
+
+    // Reuses the existing allocations when this buffer is recycled
+    void assign(const ComponentPool<T>& pool)
+    {
+        entities_.assign(pool.entities().begin(), pool.entities().end());
+        data_.assign(pool.begin(), pool.end());
+        sparse_.assign(pool.sparse().begin(), pool.sparse().end());
+        version_ = pool.version();
+    }
+
+    std::vector<Entity> entities_;
+    std::vector<T> data_;
+    std::vector<uint32_t> sparse_;
+    uint64_t version_ = 0;
+};
+
+// One consistent state of every published pool
+template <typename... Ts>
+class Snapshot
+{
+public:
+    // Number of the publish that produced this snapshot, starting at 1
+    uint64_t sequence() const noexcept
+    {
+        return sequence_;
+    }
+
+    template <typename T>
+    const PoolSnapshot<T>& pool() const noexcept
+    {
+        return *std::get<std::shared_ptr<const PoolSnapshot<T>>>(pools_);
+    }
+
+private:
+    friend class SnapshotPublisher<Ts...>;
+
+    uint64_t sequence_ = 0;
+    std::tuple<std::shared_ptr<const PoolSnapshot<Ts>>...> pools_;
+};
+
+// Publishes read-only copies of the Ts pools of a World for other threads. The simulation
+// thread calls publish() between ticks; any thread calls acquire() and iterates the snapshot
+// it got for as long as it holds it, without locks, while the world moves on. The hand-off
+// itself is a reference count bump under a mutex.
+//
+// A pool whose version() has not moved since the last publish is not copied again: the new
+// snapshot shares the previous copy, so readers can also skip work by comparing versions.
+// Each pool has two buffers that take turns, and a buffer is only refilled once no reader
+// holds it any more; otherwise a fresh one is allocated.
+template <typename... Ts>
+class SnapshotPublisher
+{
+public:
+    using snapshot_type = Snapshot<Ts...>;
+
+    explicit SnapshotPublisher(World& world) : pools_(world.pool<Ts>()...) {}
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // Writer thread only, with no writes to the world in flight
+    std::shared_ptr<const snapshot_type> publish()
+    {
+        auto next = std::make_shared<snapshot_type>();
+        next->sequence_ = ++sequence_;
+        next->pools_ = {refresh<Ts>()...};
+
+        std::shared_ptr<const snapshot_type> published = std::move(next);
+        std::lock_guard lock(latest_mutex_);
+        latest_ = published;
+        return published;
+    }
+
+    // Latest published snapshot, or nullptr before the first publish. Safe from any thread.
+    std::shared_ptr<const snapshot_type> acquire() const
+    {
+        std::lock_guard lock(latest_mutex_);
+        return latest_;
+    }
+
+    // Number of pool copies made so far; unchanged pools do not count
+    uint64_t copies() const noexcept
+    {
+        return copies_;
+    }
+
+private:
+    template <typename T>
+    struct Buffers
+    {
+        std::shared_ptr<PoolSnapshot<T>> current;
+        std::shared_ptr<PoolSnapshot<T>> spare;
+    };
+
+    template <typename T>
+    std::shared_ptr<const PoolSnapshot<T>> refresh()
+    {
+        const ComponentPool<T>& pool = std::get<const ComponentPool<T>&>(pools_);
+        Buffers<T>& buffers = std::get<Buffers<T>>(buffers_);
+
+        if (buffers.current && buffers.current->version() == pool.version())
+            return buffers.current;
+
+        // The spare left the published snapshot one publish ago, so nobody can acquire it
+        // again: once its count is down to ours, every reader has let go
+        std::shared_ptr<PoolSnapshot<T>> next;
+        if (buffers.spare && buffers.spare.use_count() == 1)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            next = std::move(buffers.spare);
+        }
+        else
+        {
+            next = std::make_shared<PoolSnapshot<T>>();
+        }
+
+        next->assign(pool);
+        ++copies_;
+
+        buffers.spare = std::move(buffers.current);
+        buffers.current = next;
+        return next;
+    }
+
+    std::tuple<const ComponentPool<Ts>&...> pools_;
+    std::tuple<Buffers<Ts>...> buffers_;
+    uint64_t sequence_ = 0;
+    uint64_t copies_ = 0;
+    mutable std::mutex latest_mutex_;
+    std::shared_ptr<const snapshot_type> latest_;
+};
+}  // namespace acorn
@@ -0,0 +1,201 @@
+#pragma once
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "component_pool.hpp"
+#include "dynamic_bitset.hpp"
+#include "entity.hpp"
+#include "entity_manager.hpp"
+#include "exclude_view.hpp"
+#include "view.hpp"
+
+namespace acorn
+{
+// World over a component list fixed at compile time. Pools live in a tuple and are found by
+// type at compile time, so pool access has no hashing, no type erasure and no virtual calls,
+// and destroy_entity() expands to one inlined remove per pool. Entity, pool and view calls
+// match World's, so code written against one compiles against the other.
+template <typename... Components>
+class StaticWorld
+{
+    static_assert(sizeof...(Components) > 0, "a StaticWorld needs at least one component");
+
+public:
+    StaticWorld() : pools_(pool_arg<Components>()...) {}
+
+    // Pools hold a reference to em_, which a copy would have to rebind
+    StaticWorld(const StaticWorld&) = delete;
+    StaticWorld& operator=(const StaticWorld&) = delete;
+
+    const EntityManager& entity_manager() const noexcept
+    {
+        return em_;
+    }
+
+    Entity create_entity()
+    {
+        return em_.create();
+    }
+
+    bool destroy_entity(Entity e)
+    {
+        if (!em_.is_alive(e))
+            return false;
+
+        std::apply([e](auto&... pools) { (pools.remove(e), ...); }, pools_);
+        return em_.destroy(e);
+    }
+
+    // Dead and repeated handles are skipped. Returns how many entities were destroyed.
+    size_t destroy_many(std::span<const Entity> entities)
+    {
+        batch_.clear();
+        batch_bits_.resize(em_.capacity());
+
+        for (const Entity e : entities)
+        {
+            if (em_.is_alive(e) && !batch_bits_.test_and_set(e.index))
+                batch_.push_back(e);
+        }
+
+        if (!batch_.empty())
+        {
+            std::apply([&](auto&... pools) { (pools.remove_many(batch_, batch_bits_), ...); },
+                       pools_);
+        }
+
+        for (const Entity e : batch_)
+        {
+            batch_bits_.reset(e.index);
+            em_.destroy(e);
+        }
+        return batch_.size();
+    }
+
+    // Disabled entities keep their components in place but every view skips them. Toggling
+    // costs one bit in the entity manager and moves no component data.
+    bool disable(Entity e)
+    {
+        return em_.disable(e);
+    }
+
+    bool enable(Entity e) noexcept
+    {
+        return em_.enable(e);
+    }
+
+    bool is_enabled(Entity e) const noexcept
+    {
+        return em_.is_enabled(e);
+    }
+
+    template <typename T>
+    ComponentPool<T>& pool() noexcept
+    {
+        static_assert(contains<T>, "component type is not part of this StaticWorld");
+        return std::get<ComponentPool<T>>(pools_);
+    }
+
+    template <typename T>
+    const ComponentPool<T>& pool() const noexcept
+    {
+        static_assert(contains<T>, "component type is not part of this StaticWorld");
+        return std::get<ComponentPool<T>>(pools_);
+    }
+
+    template <typename T>
+    bool has(Entity e) const
+    {
+        return pool<T>().has(e);
+    }
+
+    template <typename T>
+    T* try_get(Entity e)
+    {
+        return pool<T>().try_get(e);
+    }
+
+    template <typename T>
+    const T* try_get(Entity e) const
+    {
+        return pool<T>().try_get(e);
+    }
+
+    template <typename T>
+    T& get(Entity e)
+    {
+        return pool<T>().get(e);
+    }
+
+    template <typename T>
+    const T& get(Entity e) const
+    {
+        return pool<T>().get(e);
+    }
+
+    template <typename T, typename... A>
+    T& add(Entity e, A&&... args)
+    {
+        return pool<T>().emplace(e, std::forward<A>(args)...);
+    }
+
+    template <typename T>
+    bool remove(Entity e)
+    {
+        return pool<T>().remove(e);
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] auto view()
+    {
+        return View{pool<Ts>()...};
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] const auto view() const
+    {
+        return View{pool<Ts>()...};
+    }
+
+    template <typename... Ts, typename... Excluded>
+    [[nodiscard]] auto view_exclude(acorn::Exclude<Excluded...> = {})
+    {
+        return ExcludeView<std::tuple<ComponentPool<Ts>...>,
+                           std::tuple<ComponentPool<Excluded>...>>(
+            std::forward_as_tuple(pool<Ts>()...), std::forward_as_tuple(pool<Excluded>()...));
+    }
+
+    template <typename... Ts, typename... Excluded>
+    [[nodiscard]] const auto view_exclude(acorn::Exclude<Excluded...> = {}) const
+    {
+        return ExcludeView<std::tuple<const ComponentPool<Ts>...>,
+                           std::tuple<const ComponentPool<Excluded>...>>(
+            std::forward_as_tuple(pool<Ts>()...), std::forward_as_tuple(pool<Excluded>()...));
+    }
+
+    void clear()
+    {
+        std::apply([](auto&... pools) { (pools.clear(), ...); }, pools_);
+        em_.destroy_all();
+    }
+
+private:
+    template <typename T>
+    static constexpr bool contains = (std::is_same_v<T, Components> || ...);
+
+    // One em_ per pool, to construct the tuple in place
+    template <typename>
+    EntityManager& pool_arg() noexcept
+    {
+        return em_;
+    }
+
+    EntityManager em_;
+    std::tuple<ComponentPool<Components>...> pools_;
+    std::vector<Entity> batch_;
+    DynamicBitset batch_bits_;
+};
+}  // namespace acorn
@@ -0,0 +1,20 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace acorn
+{
+namespace detail
+{
+inline std::atomic<uint32_t> next_type_slot{0};
+}  // namespace detail
+
+// Small dense id for a type, handed out on first use. Lets per-type tables be plain vectors
+// indexed by slot instead of maps keyed by std::type_index.
+template <typename T>
+uint32_t type_slot() noexcept
+{
+    static const uint32_t slot = detail::next_type_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+}  // namespace acorn
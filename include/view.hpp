@@ -1,57 +1,310 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <iterator>
 #include <limits>
+#include <stdexcept>
 #include <tuple>
-#include <vector>
+#include <type_traits>
+#include <utility>
 
 #include "component_pool.hpp"
+#include "dynamic_bitset.hpp"
 #include "entity.hpp"
+#include "membership_kernel.hpp"
 
 namespace acorn
 {
 template <typename... Pools>
 class View
 {
+    static constexpr size_t kPoolCount = sizeof...(Pools);
+    static constexpr uint32_t kAbsent = UINT32_MAX;
+
+    // Dense position of the current entity in every pool, resolved once per entity
+    using Positions = std::array<uint32_t, kPoolCount>;
+
 public:
+    using entity_type =
+        typename std::remove_cv_t<std::tuple_element_t<0, std::tuple<Pools...>>>::entity_type;
+
+    static_assert((std::is_same_v<typename std::remove_cv_t<Pools>::entity_type, entity_type> &&
+                   ...),
+                  "all pools of a view must use the same entity handle type");
+
+    // Entities between the sparse and dense prefetch stages of each_prefetched()
+    static constexpr size_t kDefaultLookahead = 16;
+
     template <typename Pool>
-    auto& get_component(Entity e) const
+    auto& get_component(entity_type e) const
     {
         return std::get<Pool&>(pools_).get(e);
     }
 
     View(Pools&... pools) : pools_(std::forward_as_tuple(pools...))
     {
+        static_assert(((std::remove_cv_t<Pools>::kAbsent == kAbsent) && ...));
+
         size_t min_size = std::numeric_limits<size_t>::max();
+        size_t index = 0;
 
         auto find_smallest = [&](auto& pool)
         {
             if (pool.size() < min_size)
             {
                 min_size = pool.size();
-                lead_entities_ = &pool.entities();
+                lead_ = index;
             }
+            ++index;
         };
         (find_smallest(pools), ...);
     }
 
-    bool contains_all(Entity e) const
+    bool contains_all(entity_type e) const
     {
         return std::apply([e](auto&... pools) { return (pools.has(e) && ...); }, pools_);
     }
 
+    // Every way of iterating a view skips entities disabled in the entity manager
     template <typename Func>
     void each(Func&& f) const
     {
-        if (!lead_entities_)
-            return;
+        each_where([](entity_type) { return true; }, f);
+    }
+
+    // each() restricted to entities for which `filter(e)` holds. The filter runs after the
+    // pools matched, so it only sees live, enabled entities that carry every component.
+    template <typename Filter, typename Func>
+    void each_where(Filter&& filter, Func&& f) const
+    {
+        mark_modified();
+        with_lead_enabled(
+            [&](auto lead, auto enabled)
+            {
+                constexpr size_t L = decltype(lead)::value;
+                const auto& entities = std::get<L>(pools_).entities();
+
+                Positions pos;
+                for (size_t i = 0; i < entities.size(); ++i)
+                {
+                    const entity_type e = entities[i];
+                    if (enabled(e) && resolve<L>(e, static_cast<uint32_t>(i), pos) && filter(e))
+                    {
+                        invoke(f, e, pos);
+                    }
+                }
+            });
+    }
+
+    // each() that tolerates structural changes made by f, for single-pass systems such as
+    // "destroy whatever died". Walks the lead pool backwards over the entities it held at the
+    // start and re-reads every pool on each step. While visiting entity e, f may:
+    //  - remove components from e, or destroy e, in any pool, lead included;
+    //  - add components to any entity in any pool.
+    // Every entity of the starting set that still matches when reached is visited once.
+    // Entities that gain the components during the pass are not visited. The references f
+    // receives are invalidated by whatever structural change f itself makes. Removing
+    // components of entities other than e is not covered.
+    template <typename Func>
+    void each_safe(Func&& f) const
+    {
+        each_safe_where([](entity_type) { return true; }, f);
+    }
+
+    template <typename Filter, typename Func>
+    void each_safe_where(Filter&& filter, Func&& f) const
+    {
+        mark_modified();
+        with_lead_enabled(
+            [&](auto lead, auto enabled)
+            {
+                constexpr size_t L = decltype(lead)::value;
+                const auto& lead_pool = std::get<L>(pools_);
+
+                // Removing e swaps the last entity into its slot. Walking down, that entity
+                // was either visited already or appended during the pass, so nothing shifts
+                // into the part still to come.
+                Positions pos;
+                for (size_t i = lead_pool.size(); i-- > 0;)
+                {
+                    if (i >= lead_pool.size())
+                        continue;
+
+                    const entity_type e = lead_pool.entities()[i];
+                    if (enabled(e) && resolve<L>(e, static_cast<uint32_t>(i), pos) && filter(e))
+                    {
+                        invoke(f, e, pos);
+                    }
+                }
+            });
+    }
 
-        for (Entity e : *lead_entities_)
+    // Software-pipelined variant of each(): while visiting lead entity i it prefetches the sparse
+    // slots of entity i + 2 * lookahead and, using the now-warm sparse slots, the components of
+    // entity i + lookahead in every other pool. Pays off once the pools no longer fit in cache
+    // and the non-lead lookups stop following the lead's dense order.
+    template <typename Func>
+    void each_prefetched(Func&& f, size_t lookahead = kDefaultLookahead) const
+    {
+        if (lookahead == 0)
+            lookahead = 1;
+        mark_modified();
+
+        with_lead_enabled(
+            [&](auto lead, auto enabled)
+            {
+                constexpr size_t L = decltype(lead)::value;
+                const entity_type* entities = std::get<L>(pools_).entities().data();
+                const size_t n = std::get<L>(pools_).entities().size();
+
+                Positions pos;
+                auto visit = [&](size_t i)
+                {
+                    if (enabled(entities[i]) &&
+                        resolve<L>(entities[i], static_cast<uint32_t>(i), pos))
+                    {
+                        invoke(f, entities[i], pos);
+                    }
+                };
+
+                // Prime the pipeline so the first entities already have both stages in flight
+                for (size_t i = 0; i < std::min(n, 2 * lookahead); ++i)
+                {
+                    prefetch_sparse<L>(entities[i]);
+                }
+                for (size_t i = 0; i < std::min(n, lookahead); ++i)
+                {
+                    prefetch_components<L>(entities[i]);
+                }
+
+                size_t i = 0;
+                for (; i + 2 * lookahead < n; ++i)
+                {
+                    prefetch_sparse<L>(entities[i + 2 * lookahead]);
+                    prefetch_components<L>(entities[i + lookahead]);
+                    visit(i);
+                }
+                for (; i + lookahead < n; ++i)
+                {
+                    prefetch_components<L>(entities[i + lookahead]);
+                    visit(i);
+                }
+                for (; i < n; ++i)
+                {
+                    visit(i);
+                }
+            });
+    }
+
+    // each() resolving membership a block of lead entities at a time: for every other pool the
+    // sparse slots of the whole block are gathered at once, with AVX2 or AVX-512 when the CPU
+    // has them, into a match mask whose set lanes are then handed to f in order. Pays off when
+    // many lead entities miss, where each() takes a hard-to-predict branch per entity.
+    template <typename Func>
+    void each_batched(Func&& f) const
+    {
+        mark_modified();
+        with_lead_enabled(
+            [&](auto lead, auto enabled)
+            {
+                constexpr size_t L = decltype(lead)::value;
+                constexpr size_t B = detail::kMembershipBlock;
+                constexpr uint32_t kFullBlock = B == 32 ? UINT32_MAX : (uint32_t{1} << B) - 1;
+
+                const auto& entities = std::get<L>(pools_).entities();
+                const size_t n = entities.size();
+
+                uint32_t indices[B];
+                std::array<std::array<uint32_t, B>, kPoolCount> block;
+                Positions pos;
+
+                size_t i = 0;
+                for (; i + B <= n; i += B)
+                {
+                    for (size_t k = 0; k < B; ++k)
+                    {
+                        indices[k] = entities[i + k].index;
+                    }
+
+                    uint32_t mask = kFullBlock;
+                    [&]<size_t... Is>(std::index_sequence<Is...>)
+                    {
+                        (void)((Is == L || (mask &= gather<Is>(indices, block[Is])) != 0) && ...);
+                    }(std::make_index_sequence<kPoolCount>{});
+
+                    while (mask != 0)
+                    {
+                        const auto k = static_cast<size_t>(std::countr_zero(mask));
+                        const auto lead_pos = static_cast<uint32_t>(i + k);
+                        mask &= mask - 1;
+                        if (!enabled(entities[i + k]))
+                            continue;
+                        [&]<size_t... Is>(std::index_sequence<Is...>)
+                        {
+                            ((pos[Is] = Is == L ? lead_pos : block[Is][k]), ...);
+                        }(std::make_index_sequence<kPoolCount>{});
+                        invoke(f, entities[i + k], pos);
+                    }
+                }
+
+                for (; i < n; ++i)
+                {
+                    if (enabled(entities[i]) &&
+                        resolve<L>(entities[i], static_cast<uint32_t>(i), pos))
+                        invoke(f, entities[i], pos);
+                }
+            });
+    }
+
+    // each() driven by the pools' presence bitsets (ComponentPool::track_presence) rather than
+    // the lead's dense array: the bitsets are ANDed 64 entity indices at a time and only set
+    // bits are visited, so 64 indices that match nowhere cost a single word test. Entities come
+    // in index order. Throws std::logic_error unless every pool tracks presence.
+    template <typename Func>
+    void each_present(Func&& f) const
+    {
+        each_present_except([](size_t) { return uint64_t{0}; }, f);
+    }
+
+    // each_present() that also skips the indices set in excluded(w), a mask for word w
+    template <typename Excluded, typename Func>
+    void each_present_except(Excluded&& excluded, Func&& f) const
+    {
+        mark_modified();
+        const auto sets = std::apply(
+            [](auto&... pools)
+            { return std::array<const DynamicBitset*, kPoolCount>{pools.presence()...}; },
+            pools_);
+
+        size_t words = std::numeric_limits<size_t>::max();
+        for (const DynamicBitset* set : sets)
+        {
+            if (set == nullptr)
+                throw std::logic_error(
+                    "acorn::View: each_present needs presence tracking on every pool");
+            words = std::min(words, set->word_count());
+        }
+
+        const DynamicBitset& disabled = entity_manager().disabled();
+        Positions pos;
+        for (size_t w = 0; w < words; ++w)
         {
-            // contains_all performs the sparse lookups
-            if (contains_all(e))
+            uint64_t bits = ~(excluded(w) | disabled.word(w));
+            for (const DynamicBitset* set : sets)
+            {
+                bits &= set->word(w);
+            }
+
+            while (bits != 0)
             {
-                // Direct application to the function avoids the iterator overhead
-                std::apply([&](auto&... pools) { f(e, pools.get(e)...); }, pools_);
+                const size_t index = w * DynamicBitset::kWordBits + std::countr_zero(bits);
+                bits &= bits - 1;
+                [&]<size_t... Is>(std::index_sequence<Is...>)
+                {
+                    ((pos[Is] = std::get<Is>(pools_).sparse()[index]), ...);
+                }(std::make_index_sequence<kPoolCount>{});
+                invoke(f, std::get<0>(pools_).entities()[pos[0]], pos);
             }
         }
     }
@@ -60,21 +313,21 @@ public:
     {
     public:
         using iterator_category = std::forward_iterator_tag;
-        using value_type = Entity;
+        using value_type = entity_type;
         using difference_type = std::ptrdiff_t;
-        using pointer = Entity*;
-        using reference = Entity&;
+        using pointer = entity_type*;
+        using reference = entity_type&;
 
-        Iterator(const View& view, size_t index) : view_(view), index_(index)
+        Iterator(const View& view, size_t index)
+            : view_(view), disabled_(view.entity_manager().disabled()), index_(index)
         {
             move_to_valid();
         }
 
         auto operator*() const
         {
-            return std::forward_as_tuple(
-                (*view_.lead_entities_)[index_],
-                view_.template get_component<Pools>((*view_.lead_entities_)[index_])...);
+            return view_.components_at(entity_, positions_,
+                                       std::make_index_sequence<kPoolCount>{});
         }
 
         Iterator& operator++()
@@ -95,31 +348,151 @@ public:
         }
 
     private:
+        // Stops on the next match with its positions already resolved, so dereferencing does no
+        // further lookups
         void move_to_valid()
         {
-            while (view_.lead_entities_ && index_ < view_.lead_entities_->size() &&
-                   !view_.contains_all((*view_.lead_entities_)[index_]))
-            {
-                index_++;
-            }
+            view_.with_lead(
+                [&](auto lead)
+                {
+                    constexpr size_t L = decltype(lead)::value;
+                    const auto& entities = std::get<L>(view_.pools_).entities();
+
+                    for (; index_ < entities.size(); ++index_)
+                    {
+                        entity_ = entities[index_];
+                        if (view_.template resolve<L>(entity_, static_cast<uint32_t>(index_),
+                                                      positions_) &&
+                            !disabled_.test(entity_.index))
+                            return;
+                    }
+                });
         }
 
         const View& view_;
+        const DynamicBitset& disabled_;
         size_t index_;
+        entity_type entity_{};
+        Positions positions_{};
     };
 
     [[nodiscard]] Iterator begin() const
     {
+        mark_modified();
         return Iterator{*this, 0};
     }
 
     [[nodiscard]] Iterator end() const
     {
-        return Iterator{*this, lead_entities_ ? lead_entities_->size() : 0};
+        size_t lead_size = 0;
+        with_lead([&](auto lead) { lead_size = std::get<decltype(lead)::value>(pools_).size(); });
+        return Iterator{*this, lead_size};
     }
 
 private:
+    // Every pass may write through the pools held mutably, so each one bumps their version()
+    // once up front rather than per component
+    void mark_modified() const noexcept
+    {
+        std::apply(
+            [](auto&... pools)
+            {
+                auto bump = [](auto& pool)
+                {
+                    if constexpr (!std::is_const_v<std::remove_reference_t<decltype(pool)>>)
+                        pool.mark_modified();
+                };
+                (bump(pools), ...);
+            },
+            pools_);
+    }
+
+    // Calls fn(std::integral_constant<size_t, lead_>) so the loops below are instantiated once
+    // per possible lead pool and know at compile time which pool needs no sparse lookup
+    template <typename Fn>
+    void with_lead(Fn&& fn) const
+    {
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            (void)((lead_ == Is ? (fn(std::integral_constant<size_t, Is>{}), true) : false) ||
+                   ...);
+        }(std::make_index_sequence<kPoolCount>{});
+    }
+
+    const auto& entity_manager() const noexcept
+    {
+        return std::get<0>(pools_).entity_manager();
+    }
+
+    // with_lead() that also passes an enabled(e) predicate for skipping disabled entities.
+    // With none disabled the predicate's null test is loop-invariant and predicted.
+    template <typename Fn>
+    void with_lead_enabled(Fn&& fn) const
+    {
+        const auto& em = entity_manager();
+        const DynamicBitset* disabled = em.disabled_count() != 0 ? &em.disabled() : nullptr;
+        with_lead([&](auto lead)
+                  { fn(lead, [disabled](entity_type e)
+                       { return disabled == nullptr || !disabled->test(e.index); }); });
+    }
+
+    // Fills pos with the entity's dense position in every pool. The lead pool is addressed by
+    // the index we are iterating at, the others through a bare sparse read: `e` comes from the
+    // lead's dense array, so it is alive and a present sparse slot can only belong to it.
+    template <size_t Lead>
+    bool resolve(entity_type e, uint32_t lead_pos, Positions& pos) const noexcept
+    {
+        return [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            return ((pos[Is] = Is == Lead ? lead_pos : std::get<Is>(pools_).position(e),
+                     pos[Is] != kAbsent) &&
+                    ...);
+        }(std::make_index_sequence<kPoolCount>{});
+    }
+
+    // Dense positions of a block of entity indices in pool I, and the mask of those present
+    template <size_t I>
+    uint32_t gather(const uint32_t* indices,
+                    std::array<uint32_t, detail::kMembershipBlock>& out) const noexcept
+    {
+        const auto sparse = std::get<I>(pools_).sparse();
+        return detail::membership_kernel(sparse.size())(indices, sparse.data(), sparse.size(),
+                                                       out.data());
+    }
+
+    template <typename Func>
+    void invoke(Func& f, entity_type e, const Positions& pos) const
+    {
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        { f(e, std::get<Is>(pools_).data_at(pos[Is])...); }(std::make_index_sequence<kPoolCount>{});
+    }
+
+    template <size_t... Is>
+    auto components_at(const entity_type& e, const Positions& pos,
+                       std::index_sequence<Is...>) const
+    {
+        return std::forward_as_tuple(e, std::get<Is>(pools_).data_at(pos[Is])...);
+    }
+
+    template <size_t Lead>
+    void prefetch_sparse(entity_type e) const noexcept
+    {
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            ((Is != Lead ? std::get<Is>(pools_).prefetch_sparse(e) : void()), ...);
+        }(std::make_index_sequence<kPoolCount>{});
+    }
+
+    template <size_t Lead>
+    void prefetch_components(entity_type e) const noexcept
+    {
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            ((Is != Lead ? std::get<Is>(pools_).prefetch_component(e) : void()), ...);
+        }(std::make_index_sequence<kPoolCount>{});
+    }
+
     std::tuple<Pools&...> pools_;
-    const std::vector<Entity>* lead_entities_ = nullptr;
+    size_t lead_ = 0;
 };
-}  // namespace acorn
\ No newline at end of file
+}  // namespace acorn
@@ -1,15 +1,29 @@
 #pragma once
 #include <functional>
 #include <memory>
+#include <span>
 #include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 #include "acorn_assert.hpp"
 #include "component_pool.hpp"
+#include "dynamic_bitset.hpp"
 #include "entity.hpp"
 #include "entity_manager.hpp"
+#include "event_channel.hpp"
 #include "exclude_view.hpp"
+#include "hierarchy.hpp"
+#include "prefab.hpp"
+#include "runtime_pool.hpp"
+#include "runtime_view.hpp"
+#include "shared_pool.hpp"
+#include "shared_view.hpp"
+#include "type_slot.hpp"
 #include "view.hpp"
 
 namespace acorn
@@ -17,21 +31,304 @@ namespace acorn
 class World
 {
 public:
+    World() = default;
+
+    // Deep copy, e.g. to run a sandboxed simulation. The copy starts with the same slots and
+    // generations, so handles from `other` stay valid in it. Pools are copied wholesale, and
+    // pending deferred commands are copied too.
+    World(const World& other)
+        : em_(std::make_unique<EntityManager>(*other.em_)),
+          commands_(other.commands_),
+          hibernating_(other.hibernating_)
+    {
+        if (other.hierarchy_)
+            hierarchy_ = std::make_unique<Hierarchy>(*em_, *other.hierarchy_);
+
+        pools_.reserve(other.pools_.size());
+        for (const auto& [type, pool_ptr] : other.pools_)
+        {
+            pools_.emplace(type, pool_ptr->clone(*em_));
+        }
+
+        resources_.resize(other.resources_.size());
+        for (size_t i = 0; i < resources_.size(); ++i)
+        {
+            if (const auto& box = other.resources_[i].box)
+            {
+                resources_[i].box = box->clone();
+                resources_[i].ptr = resources_[i].box->data();
+            }
+        }
+
+        runtime_pools_.reserve(other.runtime_pools_.size());
+        for (const auto& pool : other.runtime_pools_)
+        {
+            runtime_pools_.push_back(std::make_unique<RuntimePool>(*em_, *pool));
+        }
+        runtime_cold_.reserve(other.runtime_cold_.size());
+        for (const auto& pool : other.runtime_cold_)
+        {
+            runtime_cold_.push_back(std::make_unique<RuntimePool>(*em_, *pool));
+        }
+
+        channels_.resize(other.channels_.size());
+        for (size_t i = 0; i < channels_.size(); ++i)
+        {
+            if (other.channels_[i])
+                channels_[i] = other.channels_[i]->clone();
+        }
+    }
+
+    // Pools hold a reference to the entity manager, which lives on the heap so that moves
+    // leave it in place. A moved-from World may only be destroyed or assigned to.
+    World(World&&) noexcept = default;
+    World& operator=(World&&) noexcept = default;
+    World& operator=(const World&) = delete;
+
+    // For structures kept beside the world's pools, such as a standalone Hierarchy
+    const EntityManager& entity_manager() const noexcept
+    {
+        return *em_;
+    }
+
     Entity create_entity()
     {
-        return em_.create();
+        return em_->create();
     }
 
     bool destroy_entity(Entity e)
     {
-        if (!em_.is_alive(e))
+        if (!em_->is_alive(e))
             return false;
 
         for (auto& [type, pool_ptr] : pools_)
         {
             pool_ptr->remove(e);
         }
-        return em_.destroy(e);
+        for (auto& pool : runtime_pools_)
+        {
+            pool->remove(e);
+        }
+        if (hibernating_.test(e.index))
+        {
+            hibernating_.reset(e.index);
+            for (auto& pool : runtime_cold_)
+            {
+                pool->remove(e);
+            }
+        }
+        if (hierarchy_)
+            hierarchy_->remove(e);
+        return em_->destroy(e);
+    }
+
+    // Destroys a batch with one virtual call per pool rather than one per pool per entity.
+    // Dead and repeated handles are skipped. Returns how many entities were destroyed.
+    size_t destroy_many(std::span<const Entity> entities)
+    {
+        batch_.clear();
+        batch_bits_.resize(em_->capacity());
+
+        for (const Entity e : entities)
+        {
+            if (em_->is_alive(e) && !batch_bits_.test_and_set(e.index))
+                batch_.push_back(e);
+        }
+
+        if (!batch_.empty())
+        {
+            for (auto& [type, pool_ptr] : pools_)
+            {
+                pool_ptr->remove_many(batch_, batch_bits_);
+            }
+            for (auto& pool : runtime_pools_)
+            {
+                pool->remove_many(batch_, batch_bits_);
+            }
+            for (auto& pool : runtime_cold_)
+            {
+                pool->remove_many(batch_, batch_bits_);
+            }
+            if (hierarchy_)
+            {
+                for (const Entity e : batch_)
+                {
+                    hierarchy_->remove(e);
+                }
+            }
+        }
+
+        // Clear only the bits we set, so the scratch bitset stays O(batch) to reuse
+        for (const Entity e : batch_)
+        {
+            batch_bits_.reset(e.index);
+            hibernating_.reset(e.index);
+            em_->destroy(e);
+        }
+        return batch_.size();
+    }
+
+    // Hibernation parks every component of an entity in cold pools kept beside the hot ones,
+    // so the hot dense arrays, and every view over them, only hold active entities. The
+    // handle stays valid: destroy_entity() works as usual, while has(), get() and views see
+    // none of the parked components until wake(). remove<T>() and make_prefab() do reach them.
+    // A component added while hibernating is overwritten on wake by a parked one of the same
+    // type.
+    bool hibernate(Entity e)
+    {
+        return hibernate_many(std::span(&e, 1)) == 1;
+    }
+
+    bool wake(Entity e)
+    {
+        return wake_many(std::span(&e, 1)) == 1;
+    }
+
+    // One virtual call per pool for the whole batch. Dead, repeated and already hibernating
+    // handles are skipped. Returns how many entities went to sleep.
+    size_t hibernate_many(std::span<const Entity> entities)
+    {
+        batch_.clear();
+        hibernating_.resize(em_->capacity());
+        for (const Entity e : entities)
+        {
+            if (em_->is_alive(e) && !hibernating_.test_and_set(e.index))
+                batch_.push_back(e);
+        }
+        if (batch_.empty())
+            return 0;
+
+        for (auto& [_, pool_ptr] : pools_)
+        {
+            pool_ptr->hibernate(batch_);
+        }
+        for (size_t id = runtime_cold_.size(); id < runtime_pools_.size(); ++id)
+        {
+            runtime_cold_.push_back(std::make_unique<RuntimePool>(
+                *em_, static_cast<RuntimeComponentId>(id), runtime_pools_[id]->layout()));
+        }
+        for (size_t id = 0; id < runtime_pools_.size(); ++id)
+        {
+            move_runtime(*runtime_pools_[id], *runtime_cold_[id], batch_);
+        }
+        return batch_.size();
+    }
+
+    // Restores hibernating entities in bulk; other handles are skipped. Returns how many woke.
+    size_t wake_many(std::span<const Entity> entities)
+    {
+        batch_.clear();
+        for (const Entity e : entities)
+        {
+            if (em_->is_alive(e) && hibernating_.test(e.index))
+            {
+                hibernating_.reset(e.index);
+                batch_.push_back(e);
+            }
+        }
+        if (batch_.empty())
+            return 0;
+
+        for (auto& [_, pool_ptr] : pools_)
+        {
+            pool_ptr->wake(batch_);
+        }
+        for (size_t id = 0; id < runtime_cold_.size(); ++id)
+        {
+            move_runtime(*runtime_cold_[id], *runtime_pools_[id], batch_);
+        }
+        return batch_.size();
+    }
+
+    bool is_hibernating(Entity e) const noexcept
+    {
+        return em_->is_alive(e) && hibernating_.test(e.index);
+    }
+
+    // Parent/child relationships between this world's entities, created on first use.
+    // Destroying an entity removes it, handing its children to its parent.
+    Hierarchy& hierarchy()
+    {
+        if (!hierarchy_)
+            hierarchy_ = std::make_unique<Hierarchy>(*em_);
+        return *hierarchy_;
+    }
+
+    const Hierarchy& hierarchy() const
+    {
+        if (!hierarchy_)
+            throw std::runtime_error("acorn::World: no hierarchy has been created yet");
+        return *hierarchy_;
+    }
+
+    // Disabled entities keep their components in place but every view skips them. Toggling
+    // costs one bit in the entity manager and moves no component data.
+    bool disable(Entity e)
+    {
+        return em_->disable(e);
+    }
+
+    bool enable(Entity e) noexcept
+    {
+        return em_->enable(e);
+    }
+
+    bool is_enabled(Entity e) const noexcept
+    {
+        return em_->is_enabled(e);
+    }
+
+    // Captures the components `e` currently has, or had parked if it is hibernating
+    [[nodiscard]] Prefab make_prefab(Entity e) const
+    {
+        if (!em_->is_alive(e))
+            throw std::out_of_range("acorn::World: cannot make a prefab from a dead entity");
+
+        const bool parked = hibernating_.test(e.index);
+        Prefab prefab;
+        for (const auto& [type, pool_ptr] : pools_)
+        {
+            pool_ptr->capture(e, prefab, parked);
+        }
+
+        // Runtime pools registered after the last hibernate_many() have no cold twin yet
+        const auto& runtime = parked ? runtime_cold_ : runtime_pools_;
+        for (const auto& pool : runtime)
+        {
+            if (const std::byte* bytes = pool->try_get(e))
+                prefab.set_runtime(pool->id(), {bytes, pool->layout().size});
+        }
+        return prefab;
+    }
+
+    // Creates `count` entities carrying the prefab's components. Runtime components are
+    // checked against this world's registrations before any entity is created.
+    std::vector<Entity> instantiate(const Prefab& prefab, size_t count)
+    {
+        for (const auto& part : prefab.runtime_parts_)
+        {
+            if (runtime_pool(part.id).layout().size != part.bytes.size())
+                throw std::invalid_argument("acorn::World: prefab bytes do not match the size "
+                                            "of runtime component '" +
+                                            runtime_pool(part.id).layout().name + "'");
+        }
+
+        std::vector<Entity> entities;
+        entities.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            entities.push_back(em_->create());
+        }
+
+        for (const auto& part : prefab.parts_)
+        {
+            part.stamp(*this, entities);
+        }
+        for (const auto& part : prefab.runtime_parts_)
+        {
+            runtime_pool(part.id).emplace_many(entities, part.bytes);
+        }
+        return entities;
     }
 
     template <typename T>
@@ -41,7 +338,7 @@ public:
         auto it = pools_.find(key);
         if (it == pools_.end())
         {
-            auto box = std::make_unique<PoolBox<T>>(em_);
+            auto box = std::make_unique<PoolBox<T>>(*em_);
             auto* out = &box->pool;
             pools_.emplace(key, std::move(box));
             return *out;
@@ -108,12 +405,14 @@ public:
         return pool<T>().emplace(e, std::forward<A>(args)...);
     }
 
+    // Through the box rather than the pool, so a hibernating entity loses its parked T too
     template <typename T>
     bool remove(Entity e)
     {
-        if (auto* p = try_pool<T>())
-            return p->remove(e);
-        return false;
+        auto it = pools_.find(std::type_index(typeid(T)));
+        if (it == pools_.end())
+            return false;
+        return static_cast<PoolBox<T>*>(it->second.get())->remove(e);
     }
 
     template <typename... Components>
@@ -147,14 +446,222 @@ public:
             std::forward_as_tuple(pool<Excluded>()...));
     }
 
+    // Shared components: equal values are stored once and entities are grouped by value. They
+    // live beside, not in, pool<T>(), so an entity may hold both a T and a shared T.
+    template <typename T>
+    SharedPool<T>& shared()
+    {
+        const auto key = std::type_index(typeid(Shared<T>));
+        auto it = pools_.find(key);
+        if (it == pools_.end())
+        {
+            auto box = std::make_unique<SharedPoolBox<T>>(*em_);
+            auto* out = &box->pool;
+            pools_.emplace(key, std::move(box));
+            return *out;
+        }
+        return static_cast<SharedPoolBox<T>*>(it->second.get())->pool;
+    }
+
+    template <typename T>
+    const SharedPool<T>& shared() const
+    {
+        auto it = pools_.find(std::type_index(typeid(Shared<T>)));
+        if (it == pools_.end())
+            throw std::runtime_error("acorn::World: shared component type not yet registered");
+        return static_cast<const SharedPoolBox<T>*>(it->second.get())->pool;
+    }
+
+    // Groups the entities holding a shared S by value, joined with the Components pools
+    template <typename S, typename... Components>
+    [[nodiscard]] auto view_shared()
+    {
+        return SharedView<SharedPool<S>, ComponentPool<Components>...>(shared<S>(),
+                                                                        pool<Components>()...);
+    }
+
+    // Runtime components: pools described by a ComponentLayout rather than a C++ type, e.g. for
+    // a scripting layer. Ids are handed out densely and stay valid for the world's lifetime.
+    // Names must be unique.
+    RuntimeComponentId register_component(ComponentLayout layout)
+    {
+        for (const auto& pool : runtime_pools_)
+        {
+            if (pool->layout().name == layout.name)
+                throw std::invalid_argument("acorn::World: runtime component '" + layout.name +
+                                            "' is already registered");
+        }
+
+        const auto id = static_cast<RuntimeComponentId>(runtime_pools_.size());
+        runtime_pools_.push_back(std::make_unique<RuntimePool>(*em_, id, std::move(layout)));
+        return id;
+    }
+
+    RuntimeComponentId runtime_component(std::string_view name) const
+    {
+        for (const auto& pool : runtime_pools_)
+        {
+            if (pool->layout().name == name)
+                return pool->id();
+        }
+        throw std::out_of_range("acorn::World: unknown runtime component");
+    }
+
+    RuntimePool& runtime_pool(RuntimeComponentId id)
+    {
+        if (id >= runtime_pools_.size())
+            throw std::out_of_range("acorn::World: unknown runtime component id");
+        return *runtime_pools_[id];
+    }
+
+    const RuntimePool& runtime_pool(RuntimeComponentId id) const
+    {
+        if (id >= runtime_pools_.size())
+            throw std::out_of_range("acorn::World: unknown runtime component id");
+        return *runtime_pools_[id];
+    }
+
+    [[nodiscard]] RuntimeView runtime_view(std::span<const RuntimeComponentId> include,
+                                           std::span<const RuntimeComponentId> exclude = {})
+    {
+        std::vector<RuntimePool*> included;
+        for (const RuntimeComponentId id : include)
+        {
+            included.push_back(&runtime_pool(id));
+        }
+
+        std::vector<const RuntimePool*> excluded;
+        for (const RuntimeComponentId id : exclude)
+        {
+            excluded.push_back(&runtime_pool(id));
+        }
+        return RuntimeView(std::move(included), std::move(excluded));
+    }
+
+    // Resources: one instance per type, held outside the sparse sets. Access is a bounds check
+    // and a pointer load through the type's slot, with no hashing or liveness test.
+    template <typename T, typename... Args>
+    T& set_resource(Args&&... args)
+    {
+        const uint32_t slot = type_slot<T>();
+        if (slot >= resources_.size())
+            resources_.resize(slot + 1);
+
+        auto box = std::make_unique<ResourceBox<T>>(std::forward<Args>(args)...);
+        resources_[slot].ptr = box->data();
+        resources_[slot].box = std::move(box);
+        return *static_cast<T*>(resources_[slot].ptr);
+    }
+
+    template <typename T>
+    T* try_resource() noexcept
+    {
+        const uint32_t slot = type_slot<T>();
+        return slot < resources_.size() ? static_cast<T*>(resources_[slot].ptr) : nullptr;
+    }
+
+    template <typename T>
+    const T* try_resource() const noexcept
+    {
+        const uint32_t slot = type_slot<T>();
+        return slot < resources_.size() ? static_cast<const T*>(resources_[slot].ptr) : nullptr;
+    }
+
+    template <typename T>
+    T& resource()
+    {
+        if (auto* p = try_resource<T>())
+            return *p;
+        throw std::out_of_range("acorn::World: resource not set");
+    }
+
+    template <typename T>
+    const T& resource() const
+    {
+        if (auto* p = try_resource<T>())
+            return *p;
+        throw std::out_of_range("acorn::World: resource not set");
+    }
+
+    template <typename T>
+    bool has_resource() const noexcept
+    {
+        return try_resource<T>() != nullptr;
+    }
+
+    template <typename T>
+    bool remove_resource() noexcept
+    {
+        const uint32_t slot = type_slot<T>();
+        if (slot >= resources_.size() || !resources_[slot].ptr)
+            return false;
+
+        resources_[slot].ptr = nullptr;
+        resources_[slot].box.reset();
+        return true;
+    }
+
+    // Resolves several resources at once, for systems to bind before iterating:
+    //   auto [time, input] = world.resources<Time, Input>();
+    template <typename... Resources>
+    std::tuple<Resources&...> resources()
+    {
+        return std::tuple<Resources&...>(resource<Resources>()...);
+    }
+
+    // Event channel for T, created on first use. Events are plain values in per-type buffers,
+    // so sending them creates no entities.
+    template <typename T>
+    EventChannel<T>& events()
+    {
+        const uint32_t slot = type_slot<T>();
+        if (slot >= channels_.size())
+            channels_.resize(slot + 1);
+
+        auto& channel = channels_[slot];
+        if (!channel)
+            channel = std::make_unique<EventChannel<T>>();
+        return static_cast<EventChannel<T>&>(*channel);
+    }
+
+    // Publishes this tick's events on every channel; call once per tick
+    void swap_events()
+    {
+        for (auto& channel : channels_)
+        {
+            if (channel)
+                channel->swap();
+        }
+    }
+
+    // Removes every entity, component and queued event for a level reset; resources are
+    // kept. Pools only touch their live components, and generations survive, so handles from
+    // before the clear stay invalid. The cost follows the live entities, not how many
+    // were ever alive.
     void clear()
     {
         for (auto& [_, pool_ptr] : pools_)
         {
             pool_ptr->clear();
         }
+        for (auto& pool : runtime_pools_)
+        {
+            pool->clear();
+        }
+        for (auto& pool : runtime_cold_)
+        {
+            pool->clear();
+        }
+        hibernating_.reset_all();
+        if (hierarchy_)
+            hierarchy_->clear();
+        for (auto& channel : channels_)
+        {
+            if (channel)
+                channel->clear();
+        }
 
-        em_.reset();
+        em_->destroy_all();
     }
 
     template <typename T>
@@ -178,6 +685,20 @@ public:
     }
 
 private:
+    static void move_runtime(RuntimePool& from, RuntimePool& to, std::span<const Entity> batch)
+    {
+        if (from.empty())
+            return;
+        for (const Entity e : batch)
+        {
+            if (const std::byte* bytes = from.try_get(e))
+            {
+                to.emplace(e, std::span(bytes, from.layout().size));
+                from.remove(e);
+            }
+        }
+    }
+
     template <typename T>
     ComponentPool<T>* try_pool() noexcept
     {
@@ -200,29 +721,218 @@ private:
     {
         virtual ~IPool() = default;
         virtual bool remove(Entity e) noexcept = 0;
+        virtual size_t remove_many(std::span<const Entity> batch,
+                                   const DynamicBitset& indices) noexcept = 0;
         virtual void clear() noexcept = 0;
+        virtual std::unique_ptr<IPool> clone(const EntityManager& em) const = 0;
+        virtual void capture(Entity e, Prefab& prefab, bool parked) const = 0;
+        virtual void hibernate(std::span<const Entity> batch) = 0;
+        virtual void wake(std::span<const Entity> batch) = 0;
     };
 
     template <typename T>
     struct PoolBox final : IPool
     {
         ComponentPool<T> pool;
+        ComponentPool<T> cold;  // Components of hibernating entities
+
+        explicit PoolBox(const EntityManager& em) : pool(em), cold(em) {}
+        PoolBox(const EntityManager& em, const PoolBox& other)
+            : pool(em, other.pool), cold(em, other.cold)
+        {
+        }
+
+        bool remove(Entity e) noexcept override
+        {
+            const bool parked = !cold.empty() && cold.remove(e);
+            return pool.remove(e) || parked;
+        }
+
+        size_t remove_many(std::span<const Entity> batch,
+                           const DynamicBitset& indices) noexcept override
+        {
+            cold.remove_many(batch, indices);
+            return pool.remove_many(batch, indices);
+        }
+
+        void clear() noexcept override
+        {
+            pool.clear();
+            cold.clear();
+        }
+
+        std::unique_ptr<IPool> clone(const EntityManager& em) const override
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+                return std::make_unique<PoolBox>(em, *this);
+            else
+                throw std::logic_error("acorn::World: cannot clone a non-copyable component");
+        }
+
+        void capture(Entity e, Prefab& prefab, bool parked) const override
+        {
+            const ComponentPool<T>& from = parked ? cold : pool;
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                if (const T* value = from.try_get(e))
+                    prefab.set<T>(*value);
+            }
+            else if (from.has(e))
+            {
+                throw std::logic_error("acorn::World: cannot capture a non-copyable component");
+            }
+        }
+
+        void hibernate(std::span<const Entity> batch) override
+        {
+            move_all(pool, cold, batch);
+        }
+
+        void wake(std::span<const Entity> batch) override
+        {
+            move_all(cold, pool, batch);
+        }
+
+        static void move_all(ComponentPool<T>& from, ComponentPool<T>& to,
+                             std::span<const Entity> batch)
+        {
+            if (from.empty())
+                return;
+            for (const Entity e : batch)
+            {
+                // data_at() rather than try_get(): the remove() below already bumps the version
+                if (from.has(e))
+                {
+                    to.emplace(e, std::move(from.data_at(from.position(e))));
+                    from.remove(e);
+                }
+            }
+        }
+    };
+
+    template <typename T>
+    struct SharedPoolBox final : IPool
+    {
+        SharedPool<T> pool;
+        SharedPool<T> cold;
 
-        explicit PoolBox(const EntityManager& em) : pool(em) {}
+        explicit SharedPoolBox(const EntityManager& em) : pool(em), cold(em) {}
+        SharedPoolBox(const EntityManager& em, const SharedPoolBox& other)
+            : pool(em, other.pool), cold(em, other.cold)
+        {
+        }
 
         bool remove(Entity e) noexcept override
         {
-            return pool.remove(e);
+            const bool parked = !cold.empty() && cold.remove(e);
+            return pool.remove(e) || parked;
+        }
+
+        size_t remove_many(std::span<const Entity> batch,
+                           const DynamicBitset& indices) noexcept override
+        {
+            cold.remove_many(batch, indices);
+            return pool.remove_many(batch, indices);
         }
 
         void clear() noexcept override
         {
             pool.clear();
+            cold.clear();
+        }
+
+        std::unique_ptr<IPool> clone(const EntityManager& em) const override
+        {
+            return std::make_unique<SharedPoolBox>(em, *this);
+        }
+
+        void capture(Entity e, Prefab& prefab, bool parked) const override
+        {
+            if (const T* value = (parked ? cold : pool).try_get(e))
+                prefab.share<T>(*value);
+        }
+
+        void hibernate(std::span<const Entity> batch) override
+        {
+            move_all(pool, cold, batch);
+        }
+
+        void wake(std::span<const Entity> batch) override
+        {
+            move_all(cold, pool, batch);
+        }
+
+        static void move_all(SharedPool<T>& from, SharedPool<T>& to,
+                             std::span<const Entity> batch)
+        {
+            if (from.empty())
+                return;
+            for (const Entity e : batch)
+            {
+                if (const T* value = from.try_get(e))
+                {
+                    to.emplace(e, *value);
+                    from.remove(e);
+                }
+            }
+        }
+    };
+
+    struct IResource
+    {
+        virtual ~IResource() = default;
+        virtual void* data() noexcept = 0;
+        virtual std::unique_ptr<IResource> clone() const = 0;
+    };
+
+    template <typename T>
+    struct ResourceBox final : IResource
+    {
+        T value;
+
+        template <typename... Args>
+        explicit ResourceBox(Args&&... args) : value(std::forward<Args>(args)...)
+        {
+        }
+
+        void* data() noexcept override
+        {
+            return &value;
+        }
+
+        std::unique_ptr<IResource> clone() const override
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+                return std::make_unique<ResourceBox>(value);
+            else
+                throw std::logic_error("acorn::World: cannot clone a non-copyable resource");
         }
     };
 
-    EntityManager em_;
+    // ptr caches &box->value so the hot path never goes through the vtable
+    struct ResourceSlot
+    {
+        void* ptr = nullptr;
+        std::unique_ptr<IResource> box;
+    };
+
+    std::unique_ptr<EntityManager> em_ = std::make_unique<EntityManager>();
     std::unordered_map<std::type_index, std::unique_ptr<IPool>> pools_;
+    std::vector<std::unique_ptr<RuntimePool>> runtime_pools_;
     std::vector<std::function<void(World&)>> commands_;
+
+    // Cold pools of hibernating entities, by runtime component id; created on first use
+    std::vector<std::unique_ptr<RuntimePool>> runtime_cold_;
+    DynamicBitset hibernating_;
+
+    std::unique_ptr<Hierarchy> hierarchy_;
+
+    // Scratch for destroy_many, kept to avoid reallocating per batch
+    std::vector<Entity> batch_;
+    DynamicBitset batch_bits_;
+
+    // Both indexed by type_slot<T>()
+    std::vector<ResourceSlot> resources_;
+    std::vector<std::unique_ptr<IEventChannel>> channels_;
 };
 }  // namespace acorn
\ No newline at end of file
@@ -209,3 +209,184 @@ TEST(ComponentPoolTest, ReAddAfterRemoveWorks)
     EXPECT_TRUE(pool.has(e));
     EXPECT_EQ(*pool.try_get(e), 7);
 }
+
+TEST(ComponentPoolTest, PositionAndDataAtFollowDenseLayout)
+{
+    acorn::EntityManager em;
+    acorn::ComponentPool<int> pool(em);
+
+    auto a = em.create();
+    auto b = em.create();
+    auto c = em.create();
+    pool.emplace(a, 1);
+    pool.emplace(b, 2);
+
+    EXPECT_EQ(pool.position(a), 0u);
+    EXPECT_EQ(pool.position(b), 1u);
+    EXPECT_EQ(pool.position(c), acorn::ComponentPool<int>::kAbsent);
+    EXPECT_EQ(pool.data_at(pool.position(b)), 2);
+
+    // swap-and-pop moves b into a's slot
+    pool.remove(a);
+    EXPECT_EQ(pool.position(a), acorn::ComponentPool<int>::kAbsent);
+    EXPECT_EQ(pool.position(b), 0u);
+    EXPECT_EQ(pool.data_at(0), 2);
+}
+
+namespace
+{
+struct Member
+{
+    int team;
+    int id;
+};
+}  // namespace
+
+TEST(ComponentPoolTest, HashIndexFollowsEmplaceOverwriteAndRemove)
+{
+    acorn::EntityManager em;
+    acorn::ComponentPool<Member> pool(em);
+
+    auto a = em.create();
+    auto b = em.create();
+    auto c = em.create();
+    pool.emplace(a, Member{1, 10});
+
+    // Built from existing contents, then maintained
+    auto& by_team = pool.add_hash_index(&Member::team);
+    auto& by_id = pool.add_hash_index([](const Member& m) { return m.id; });
+
+    pool.emplace(b, Member{1, 20});
+    pool.emplace(c, Member{3, 30});
+    EXPECT_EQ(by_team.count(1), 2u);
+    EXPECT_EQ(by_id.find_one(30), c);
+
+    pool.emplace(b, Member{3, 21});
+    EXPECT_EQ(by_team.count(1), 1u);
+    EXPECT_EQ(by_team.count(3), 2u);
+    EXPECT_TRUE(by_id.find_one(20).is_null());
+    EXPECT_EQ(by_id.find_one(21), b);
+
+    pool.remove(a);
+    EXPECT_EQ(by_team.count(1), 0u);
+    EXPECT_TRUE(by_id.find_one(10).is_null());
+
+    pool.clear();
+    EXPECT_TRUE(by_team.find(3).empty());
+}
+
+TEST(ComponentPoolTest, HashIndexRemovesByStoredKeyAfterDirectWrite)
+{
+    acorn::EntityManager em;
+    acorn::ComponentPool<Member> pool(em);
+    auto& by_team = pool.add_hash_index(&Member::team);
+
+    auto a = em.create();
+    auto b = em.create();
+    pool.emplace(a, Member{1, 10});
+    pool.emplace(b, Member{1, 20});
+
+    // The index is not told about the write, but removal still finds a under team 1
+    pool.get(a).team = 5;
+    pool.remove(a);
+    EXPECT_EQ(by_team.count(5), 0u);
+    ASSERT_EQ(by_team.count(1), 1u);
+    EXPECT_EQ(by_team.find_one(1), b);
+
+    // Overwriting the only member of a bucket with the same key keeps the bucket
+    pool.emplace(b, Member{1, 21});
+    EXPECT_EQ(by_team.find_one(1), b);
+}
+
+TEST(ComponentPoolTest, ThrowingIndexLeavesPoolAndIndexesUnchanged)
+{
+    acorn::EntityManager em;
+    acorn::ComponentPool<Member> pool(em);
+    auto& by_team = pool.add_hash_index(&Member::team);
+    auto& by_id = pool.add_sorted_index(
+        [](const Member& m)
+        {
+            if (m.id < 0)
+                throw std::invalid_argument("negative id");
+            return m.id;
+        });
+
+    auto a = em.create();
+    auto b = em.create();
+    pool.emplace(a, Member{1, 10});
+
+    EXPECT_THROW(pool.emplace(a, Member{2, -1}), std::invalid_argument);
+    EXPECT_EQ(pool.get(a).team, 1);
+    EXPECT_EQ(by_team.find_one(1), a);
+    EXPECT_EQ(by_team.count(2), 0u);
+    EXPECT_EQ(by_id.find_one(10), a);
+
+    EXPECT_THROW(pool.emplace(b, Member{2, -1}), std::invalid_argument);
+    EXPECT_FALSE(pool.has(b));
+    EXPECT_EQ(by_team.count(2), 0u);
+    EXPECT_EQ(by_id.size(), 1u);
+
+    const acorn::Entity batch[] = {b};
+    EXPECT_THROW(pool.emplace_many(batch, Member{2, -1}), std::invalid_argument);
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(by_team.count(2), 0u);
+}
+
+TEST(ComponentPoolTest, SortedIndexAnswersRangeQueries)
+{
+    acorn::EntityManager em;
+    acorn::ComponentPool<Member> pool(em);
+    auto& by_id = pool.add_sorted_index(&Member::id);
+
+    std::vector<acorn::Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        entities.push_back(em.create());
+        pool.emplace(entities.back(), Member{0, 100 - i * 10});
+    }
+
+    // ids 40, 50, 60 in key order
+    auto hits = by_id.range(40, 70);
+    ASSERT_EQ(hits.size(), 3u);
+    EXPECT_EQ(hits[0], entities[6]);
+    EXPECT_EQ(hits[2], entities[4]);
+
+    pool.remove(entities[5]);
+    EXPECT_EQ(by_id.range(40, 70).size(), 2u);
+    EXPECT_EQ(by_id.size(), 9u);
+    EXPECT_EQ(by_id.find_one(100), entities[0]);
+}
+
+TEST(ComponentPoolTest, PresenceTracksInsertRemoveAndClear)
+{
+    acorn::EntityManager em;
+    acorn::ComponentPool<int> pool(em);
+    EXPECT_EQ(pool.presence(), nullptr);
+
+    auto a = em.create();
+    auto b = em.create();
+    auto c = em.create();
+    pool.emplace(a, 1);
+
+    // Seeded from the current contents, then maintained
+    pool.track_presence();
+    ASSERT_NE(pool.presence(), nullptr);
+    EXPECT_TRUE(pool.presence()->test(a.index));
+
+    pool.emplace(b, 2);
+    const acorn::Entity batch[] = {c};
+    pool.emplace_many(batch, 3);
+    pool.remove(a);
+    EXPECT_FALSE(pool.presence()->test(a.index));
+    EXPECT_TRUE(pool.presence()->test(b.index));
+    EXPECT_TRUE(pool.presence()->test(c.index));
+
+    acorn::EntityManager other_em;
+    acorn::ComponentPool<int> copy(other_em, pool);
+    ASSERT_NE(copy.presence(), nullptr);
+    EXPECT_TRUE(copy.presence()->test(b.index));
+
+    pool.clear();
+    EXPECT_FALSE(pool.presence()->test(b.index));
+    EXPECT_FALSE(pool.presence()->test(c.index));
+}
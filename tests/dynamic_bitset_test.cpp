@@ -0,0 +1,38 @@
+#include "dynamic_bitset.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace acorn;
+
+TEST(DynamicBitsetTest, SetGrowsAndTestPastEndIsFalse)
+{
+    DynamicBitset bits;
+    EXPECT_FALSE(bits.test(100));
+
+    bits.set(100);
+    EXPECT_EQ(bits.size(), 101u);
+    EXPECT_EQ(bits.word_count(), 2u);
+    EXPECT_TRUE(bits.test(100));
+    EXPECT_FALSE(bits.test(99));
+    EXPECT_FALSE(bits.test(1000));
+
+    EXPECT_FALSE(bits.test_and_set(3));
+    EXPECT_TRUE(bits.test_and_set(3));
+
+    bits.reset(3);
+    EXPECT_FALSE(bits.test(3));
+}
+
+TEST(DynamicBitsetTest, ShrinkingDropsBitsPastNewSize)
+{
+    DynamicBitset bits;
+    bits.set(5);
+    bits.set(60);
+    bits.resize(10);
+    EXPECT_TRUE(bits.test(5));
+
+    // Growing again must not resurrect bit 60
+    bits.resize(64);
+    EXPECT_FALSE(bits.test(60));
+    EXPECT_EQ(bits.word(0), uint64_t{1} << 5);
+}
@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <vector>
+
 TEST(EntityManagerTest, CreateIsAlive)
 {
     acorn::EntityManager em;
@@ -67,3 +70,177 @@ TEST(EntityManagerTest, CapacityDoesNotGrowWhenReusing)
     EXPECT_TRUE(em.is_alive(e2));
     EXPECT_TRUE(em.is_alive(e3));
 }
+
+TEST(EntityManagerTest, SlotIsRetiredInsteadOfWrappingGeneration)
+{
+    // 2 generation bits: generations 0..2 are usable, 3 is reserved for null
+    acorn::BasicEntityManager<acorn::EntityTraits<8, 2>> em;
+
+    auto e = em.create();
+    const uint32_t idx = e.index;
+    for (uint32_t gen = 0; gen < 2; ++gen)
+    {
+        EXPECT_EQ(e.generation, gen);
+        EXPECT_TRUE(em.destroy(e));
+        e = em.create();
+        EXPECT_EQ(e.index, idx);
+    }
+
+    EXPECT_EQ(e.generation, 2u);
+    EXPECT_TRUE(em.destroy(e));
+
+    // The slot is exhausted, so the next entity must come from a fresh index
+    auto fresh = em.create();
+    EXPECT_NE(fresh.index, idx);
+    EXPECT_EQ(em.alive_count(), 1u);
+    EXPECT_EQ(em.capacity(), 2u);
+}
+
+TEST(EntityManagerTest, ThrowsWhenIndexSpaceIsExhausted)
+{
+    // 2 index bits: indices 0..2 are usable, 3 is the null index
+    acorn::BasicEntityManager<acorn::EntityTraits<2, 8>> em;
+    em.create();
+    em.create();
+    em.create();
+    EXPECT_THROW(em.create(), std::length_error);
+}
+
+TEST(EntityManagerTest, LifoRecyclesMostRecentlyDestroyedFirst)
+{
+    acorn::EntityManager em;
+    auto a = em.create();
+    auto b = em.create();
+    auto c = em.create();
+
+    em.destroy(a);
+    em.destroy(c);
+    em.destroy(b);
+
+    EXPECT_EQ(em.create().index, b.index);
+    EXPECT_EQ(em.create().index, c.index);
+    EXPECT_EQ(em.create().index, a.index);
+    EXPECT_EQ(em.capacity(), 3u);
+    EXPECT_EQ(em.alive_count(), 3u);
+}
+
+TEST(EntityManagerTest, LowestIndexPolicyRecyclesSmallestSlot)
+{
+    acorn::EntityManager em(0, acorn::RecyclePolicy::LowestIndex);
+
+    std::vector<acorn::Entity> es;
+    for (int i = 0; i < 200; ++i)
+        es.push_back(em.create());
+
+    em.destroy(es[150]);
+    em.destroy(es[3]);
+    em.destroy(es[70]);
+    EXPECT_EQ(em.alive_count(), 197u);
+
+    auto r1 = em.create();
+    auto r2 = em.create();
+    auto r3 = em.create();
+    EXPECT_EQ(r1.index, 3u);
+    EXPECT_EQ(r2.index, 70u);
+    EXPECT_EQ(r3.index, 150u);
+    EXPECT_EQ(r1.generation, 1u);
+
+    EXPECT_FALSE(em.is_alive(es[3]));
+    EXPECT_TRUE(em.is_alive(r1));
+    EXPECT_EQ(em.create().index, 200u);
+}
+
+TEST(EntityManagerTest, StaleHandleToFreeSlotIsNotAlive)
+{
+    acorn::EntityManager em;
+    auto a = em.create();
+    auto b = em.create();
+    em.destroy(a);
+    em.destroy(b);
+
+    // Dead slots hold free-list links; no handle, stale or forged, should match them
+    EXPECT_FALSE(em.is_alive(a));
+    EXPECT_FALSE(em.is_alive(b));
+    EXPECT_FALSE(em.is_alive(acorn::Entity{b.index, b.generation + 1}));
+    EXPECT_EQ(em.alive_count(), 0u);
+}
+
+TEST(EntityManagerTest, DestroyAllKeepsGenerations)
+{
+    acorn::EntityManager em;
+    std::vector<acorn::Entity> old;
+    for (int i = 0; i < 8; ++i)
+    {
+        old.push_back(em.create());
+    }
+    em.destroy(old[3]);
+
+    em.destroy_all();
+    EXPECT_EQ(em.alive_count(), 0u);
+    EXPECT_EQ(em.capacity(), 8u);
+
+    // Slots are reused from the bottom, but under new generations
+    auto e = em.create();
+    EXPECT_EQ(e.index, 0u);
+    EXPECT_NE(e, old[0]);
+    for (auto h : old)
+    {
+        EXPECT_FALSE(em.is_alive(h));
+    }
+}
+
+TEST(EntityManagerTest, DestroyAllFindsSurvivorsAtHighIndices)
+{
+    acorn::EntityManager em;
+    std::vector<acorn::Entity> all;
+    for (int i = 0; i < 1000; ++i)
+    {
+        all.push_back(em.create());
+    }
+    for (int i = 0; i < 997; ++i)
+    {
+        em.destroy(all[i]);
+    }
+
+    em.destroy_all();
+    EXPECT_EQ(em.alive_count(), 0u);
+    for (int i = 997; i < 1000; ++i)
+    {
+        EXPECT_FALSE(em.is_alive(all[i]));
+    }
+
+    // Survivors of a restore are found too
+    acorn::EntityManager restored;
+    const acorn::Entity saved[] = {acorn::Entity{5, 2}, acorn::Entity{700, 1}};
+    restored.restore(saved);
+    restored.destroy_all();
+    EXPECT_EQ(restored.alive_count(), 0u);
+    EXPECT_FALSE(restored.is_alive(saved[1]));
+    // Under Lifo the lowest slot destroy_all() freed comes back first
+    EXPECT_EQ(restored.create().index, 5u);
+}
+
+TEST(EntityManagerTest, DisableIsClearedWhenTheSlotDies)
+{
+    acorn::EntityManager em;
+    const acorn::Entity a = em.create();
+    const acorn::Entity b = em.create();
+
+    EXPECT_TRUE(em.disable(a));
+    EXPECT_FALSE(em.disable(a));
+    EXPECT_FALSE(em.is_enabled(a));
+    EXPECT_TRUE(em.is_enabled(b));
+    EXPECT_EQ(em.disabled_count(), 1u);
+
+    EXPECT_TRUE(em.enable(a));
+    EXPECT_FALSE(em.enable(a));
+    EXPECT_EQ(em.disabled_count(), 0u);
+
+    em.disable(b);
+    em.destroy(b);
+    EXPECT_FALSE(em.disable(b));
+    EXPECT_EQ(em.disabled_count(), 0u);
+    const acorn::Entity reused = em.create();
+    EXPECT_EQ(reused.index, b.index);
+    EXPECT_TRUE(em.is_enabled(reused));
+}
@@ -31,4 +31,24 @@ TEST(EntityTest, Equality)
 
     ASSERT_TRUE(a == b);
     ASSERT_FALSE(a == c);
-}
\ No newline at end of file
+}
+
+using CompactEntity = acorn::BasicEntity<acorn::CompactEntityTraits>;
+
+static_assert(sizeof(CompactEntity) == 4);
+static_assert(CompactEntity{}.is_null());
+static_assert(CompactEntity::null().index == (1u << 20) - 1);
+static_assert(CompactEntity::null().generation == (1u << 12) - 1);
+
+TEST(EntityTest, CompactFieldsRoundTrip)
+{
+    CompactEntity e{(1u << 20) - 2, 4094};
+    EXPECT_EQ(e.index, (1u << 20) - 2);
+    EXPECT_EQ(e.generation, 4094u);
+    EXPECT_FALSE(e.is_null());
+
+    CompactEntity same{(1u << 20) - 2, 4094};
+    CompactEntity other_gen{(1u << 20) - 2, 4093};
+    EXPECT_EQ(e, same);
+    EXPECT_NE(e, other_gen);
+}
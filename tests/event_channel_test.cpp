@@ -0,0 +1,125 @@
+#include "event_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "world.hpp"
+
+using namespace acorn;
+
+namespace
+{
+struct Damage
+{
+    int target;
+    int amount;
+};
+}  // namespace
+
+TEST(EventChannelTest, EventsBecomeReadableAfterOneSwap)
+{
+    EventChannel<Damage> channel;
+    channel.send(Damage{1, 10});
+    channel.emplace(2, 20);
+    EXPECT_TRUE(channel.read().empty());
+
+    channel.swap();
+    ASSERT_EQ(channel.read().size(), 2u);
+    EXPECT_EQ(channel.read()[1].amount, 20);
+
+    // Sent during the read phase, published by the next swap
+    std::vector<Damage> batch{{3, 30}, {4, 40}, {5, 50}};
+    channel.send_many(batch);
+    EXPECT_EQ(channel.read().size(), 2u);
+
+    channel.swap();
+    ASSERT_EQ(channel.read().size(), 3u);
+    EXPECT_EQ(channel.read()[0].target, 3);
+
+    channel.swap();
+    EXPECT_TRUE(channel.read().empty());
+}
+
+TEST(EventChannelTest, ConcurrentSendsSpillPastTheSlab)
+{
+    // A small slab forces both the lock-free path and the spill
+    EventChannel<int> channel(64);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+
+    for (int tick = 0; tick < 2; ++tick)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back(
+                [&, t]
+                {
+                    for (int i = 0; i < kPerThread; i += 5)
+                    {
+                        const int base = t * kPerThread + i;
+                        if (i % 2 == 0)
+                        {
+                            for (int k = 0; k < 5; ++k)
+                                channel.send_concurrent(base + k);
+                        }
+                        else
+                        {
+                            const int batch[] = {base, base + 1, base + 2, base + 3, base + 4};
+                            channel.send_many_concurrent(batch);
+                        }
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        channel.swap();
+
+        std::vector<int> seen(channel.read().begin(), channel.read().end());
+        std::sort(seen.begin(), seen.end());
+        ASSERT_EQ(seen.size(), size_t{kThreads * kPerThread});
+        for (int i = 0; i < kThreads * kPerThread; ++i)
+        {
+            EXPECT_EQ(seen[i], i);
+        }
+    }
+}
+
+TEST(EventChannelTest, WorldSwapsEveryChannel)
+{
+    World w;
+    w.events<Damage>().send(Damage{0, 5});
+    w.events<int>().send(7);
+
+    w.swap_events();
+    EXPECT_EQ(w.events<Damage>().read().size(), 1u);
+    EXPECT_EQ(w.events<int>().read()[0], 7);
+
+    World copy(w);
+    EXPECT_EQ(copy.events<int>().read()[0], 7);
+
+    w.events<int>().send(8);
+    w.clear();
+    w.swap_events();
+    EXPECT_TRUE(w.events<int>().read().empty());
+    EXPECT_EQ(copy.events<int>().read().size(), 1u);
+}
+
+TEST(EventChannelTest, MoveOnlyEventsWorkUntilCloned)
+{
+    World w;
+    w.events<std::unique_ptr<int>>().send(std::make_unique<int>(3));
+    w.events<std::unique_ptr<int>>().send_concurrent(std::make_unique<int>(4));
+    w.swap_events();
+    ASSERT_EQ(w.events<std::unique_ptr<int>>().read().size(), 2u);
+    EXPECT_EQ(*w.events<std::unique_ptr<int>>().read()[1], 4);
+
+    EXPECT_THROW(World{w}, std::logic_error);
+}
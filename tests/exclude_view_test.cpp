@@ -190,4 +190,64 @@ TEST(ExcludeViewTest, MutationDuringIteration_ComponentValuesCorrect)
 
     auto all = world.view<Position, FrozenTag>();
     all.each([](acorn::Entity, Position& pos, FrozenTag&) { EXPECT_FLOAT_EQ(pos.y, 0.f); });
-}
\ No newline at end of file
+}
+
+TEST(ExcludeViewTest, EachPresentMatchesEach)
+{
+    acorn::World world;
+    world.pool<Position>().track_presence();
+    world.pool<FrozenTag>().track_presence();
+
+    for (int i = 0; i < 300; i++)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, (float)i, 0.f);
+        if (i % 2 == 0)
+            world.add<FrozenTag>(e);
+    }
+
+    auto view = world.view_exclude<Position>(acorn::Exclude<FrozenTag>{});
+
+    size_t each_count = 0;
+    view.each([&](acorn::Entity, Position&) { each_count++; });
+
+    size_t present_count = 0;
+    view.each_present(
+        [&](acorn::Entity e, Position& pos)
+        {
+            EXPECT_FALSE(world.has<FrozenTag>(e));
+            EXPECT_EQ(world.get<Position>(e).x, pos.x);
+            present_count++;
+        });
+
+    EXPECT_EQ(each_count, 150);
+    EXPECT_EQ(present_count, each_count);
+}
+
+TEST(ExcludeViewTest, EachSafeAllowsTaggingCurrentEntity)
+{
+    acorn::World world;
+    for (int i = 0; i < 20; i++)
+    {
+        auto e = world.create_entity();
+        world.add<Position>(e, (float)i, 0.f);
+        if (i % 4 == 0)
+            world.add<FrozenTag>(e);
+    }
+
+    size_t visited = 0;
+    auto view = world.view_exclude<Position>(acorn::Exclude<FrozenTag>{});
+    view.each_safe(
+        [&](acorn::Entity e, Position& pos)
+        {
+            visited++;
+            if (pos.x > 10.f)
+                world.add<FrozenTag>(e);
+            else
+                world.remove<Position>(e);
+        });
+
+    EXPECT_EQ(visited, 15);
+    EXPECT_EQ(world.pool<FrozenTag>().size(), 5u + 7u);
+    EXPECT_EQ(world.pool<Position>().size(), 5u + 7u);
+}
@@ -0,0 +1,211 @@
+#include "hierarchy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "entity_manager.hpp"
+#include "world.hpp"
+
+using namespace acorn;
+
+namespace
+{
+// Every entity must be visited after its parent
+void expect_parents_first(const Hierarchy& h)
+{
+    std::vector<Entity> seen;
+    h.each(
+        [&](Entity e, Entity parent)
+        {
+            if (!parent.is_null())
+            {
+                EXPECT_NE(std::find(seen.begin(), seen.end(), parent), seen.end());
+            }
+            seen.push_back(e);
+        });
+    EXPECT_EQ(seen.size(), h.size());
+}
+}  // namespace
+
+TEST(HierarchyTest, AttachTracksParentAndDepth)
+{
+    EntityManager em;
+    Hierarchy h(em);
+    Entity root = em.create();
+    Entity child = em.create();
+    Entity grandchild = em.create();
+
+    h.attach(grandchild, child);
+    h.attach(child, root);
+
+    EXPECT_EQ(h.size(), 3u);
+    EXPECT_TRUE(h.parent(root).is_null());
+    EXPECT_EQ(h.parent(grandchild), child);
+    EXPECT_EQ(h.depth(root), 0u);
+    EXPECT_EQ(h.depth(child), 1u);
+    EXPECT_EQ(h.depth(grandchild), 2u);
+    expect_parents_first(h);
+}
+
+TEST(HierarchyTest, ReparentMovesWholeSubtree)
+{
+    EntityManager em;
+    Hierarchy h(em);
+    Entity a = em.create();
+    Entity b = em.create();
+    Entity c = em.create();
+    Entity d = em.create();
+
+    h.attach(b, a);
+    h.attach(c, b);
+    h.attach(d, c);
+
+    // Lift b's subtree to the top, then sink it under d's former sibling
+    h.attach(b);
+    EXPECT_EQ(h.depth(b), 0u);
+    EXPECT_EQ(h.depth(d), 2u);
+
+    Entity e = em.create();
+    h.attach(e, a);
+    h.attach(b, e);
+    EXPECT_EQ(h.depth(b), 2u);
+    EXPECT_EQ(h.depth(c), 3u);
+    EXPECT_EQ(h.depth(d), 4u);
+    expect_parents_first(h);
+
+    EXPECT_THROW(h.attach(a, d), std::invalid_argument);
+}
+
+TEST(HierarchyTest, RemoveHandsChildrenToGrandparent)
+{
+    EntityManager em;
+    Hierarchy h(em);
+    Entity root = em.create();
+    Entity mid = em.create();
+    Entity x = em.create();
+    Entity y = em.create();
+
+    h.attach(mid, root);
+    h.attach(x, mid);
+    h.attach(y, mid);
+
+    EXPECT_TRUE(h.remove(mid));
+    EXPECT_FALSE(h.remove(mid));
+    EXPECT_FALSE(h.has(mid));
+    EXPECT_EQ(h.parent(x), root);
+    EXPECT_EQ(h.depth(y), 1u);
+    EXPECT_THROW((void)h.parent(mid), std::out_of_range);
+
+    std::unordered_set<uint32_t> children;
+    h.each_child(root, [&](Entity c) { children.insert(c.index); });
+    EXPECT_EQ(children, (std::unordered_set<uint32_t>{x.index, y.index}));
+}
+
+TEST(HierarchyTest, SortGroupsSiblingsInParentOrder)
+{
+    EntityManager em;
+    Hierarchy h(em);
+    std::vector<Entity> roots;
+    for (int i = 0; i < 4; ++i)
+    {
+        roots.push_back(em.create());
+        h.attach(roots.back());
+    }
+    // Interleave children of different parents
+    for (int i = 0; i < 12; ++i)
+    {
+        h.attach(em.create(), roots[i % 4]);
+    }
+
+    h.sort();
+
+    std::vector<Entity> parents;
+    h.each(
+        [&](Entity, Entity parent)
+        {
+            if (!parent.is_null())
+                parents.push_back(parent);
+        });
+    ASSERT_EQ(parents.size(), 12u);
+    for (size_t i = 0; i < parents.size(); ++i)
+    {
+        EXPECT_EQ(parents[i], roots[i / 3]);
+    }
+    expect_parents_first(h);
+}
+
+TEST(HierarchyTest, OrderLinesPoolsUpForALinearPass)
+{
+    World w;
+    Hierarchy& h = w.hierarchy();
+    Entity root = w.create_entity();
+    Entity a = w.create_entity();
+    Entity b = w.create_entity();
+    Entity leaf = w.create_entity();
+    Entity loose = w.create_entity();
+    for (Entity e : {loose, leaf, b, a, root})
+    {
+        w.add<int>(e, static_cast<int>(e.index) + 1);
+    }
+    h.attach(leaf, b);
+    h.attach(a, root);
+    h.attach(b, root);
+
+    EXPECT_TRUE(h.order().empty());
+    h.sort();
+    ASSERT_EQ(h.order().size(), 4u);
+    EXPECT_EQ(h.order()[0], root);
+    EXPECT_EQ(h.order()[3], leaf);
+    EXPECT_EQ(h.parent_positions()[0], Hierarchy::kNoParent);
+    for (size_t i = 1; i < h.order().size(); ++i)
+    {
+        EXPECT_EQ(h.order()[h.parent_positions()[i]], h.parent(h.order()[i]));
+    }
+
+    // Every hierarchy entity has an int, so pool positions now match order() positions
+    auto& pool = w.pool<int>();
+    pool.sort_as(h.order());
+    for (uint32_t i = 0; i < h.order().size(); ++i)
+    {
+        EXPECT_EQ(pool.entities()[i], h.order()[i]);
+        EXPECT_EQ(pool.data_at(i), static_cast<int>(h.order()[i].index) + 1);
+    }
+    EXPECT_EQ(pool.entities()[4], loose);
+
+    h.attach(loose, leaf);
+    EXPECT_TRUE(h.order().empty());
+}
+
+TEST(HierarchyTest, WorldDestroyRemovesEntities)
+{
+    World w;
+    Hierarchy& h = w.hierarchy();
+    Entity root = w.create_entity();
+    Entity mid = w.create_entity();
+    Entity leaf = w.create_entity();
+    Entity other = w.create_entity();
+    h.attach(mid, root);
+    h.attach(leaf, mid);
+    h.attach(other, root);
+
+    w.destroy_entity(mid);
+    EXPECT_FALSE(h.has(mid));
+    EXPECT_EQ(h.parent(leaf), root);
+
+    World copy(w);
+    const std::vector<Entity> batch{root, other};
+    w.destroy_many(batch);
+    EXPECT_EQ(h.size(), 1u);
+    EXPECT_EQ(h.depth(leaf), 0u);
+    expect_parents_first(h);
+
+    EXPECT_EQ(copy.hierarchy().size(), 3u);
+    EXPECT_EQ(copy.hierarchy().parent(leaf), root);
+
+    w.clear();
+    EXPECT_EQ(h.size(), 0u);
+}
@@ -0,0 +1,141 @@
+#include "mapped_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "component_pool.hpp"
+#include "entity_manager.hpp"
+#include "view.hpp"
+
+using namespace acorn;
+
+namespace
+{
+struct Mass
+{
+    float kg;
+};
+
+using MappedPool = ComponentPool<Mass, DefaultEntityTraits, MappedStorage>;
+
+// Fresh directory per test, removed afterwards
+struct TempDir
+{
+    std::filesystem::path path;
+
+    explicit TempDir(const std::string& name)
+        : path(std::filesystem::temp_directory_path() / ("acorn_" + name))
+    {
+        std::filesystem::remove_all(path);
+    }
+
+    ~TempDir()
+    {
+        std::filesystem::remove_all(path);
+    }
+};
+}  // namespace
+
+TEST(MappedStorageTest, VectorGrowsAcrossRemaps)
+{
+    TempDir dir("mapped_vector");
+    std::filesystem::create_directories(dir.path);
+
+    {
+        MappedVector<uint32_t> v(dir.path / "v.bin");
+        for (uint32_t i = 0; i < 10000; ++i)
+        {
+            v.push_back(i);
+        }
+        v.pop_back();
+        EXPECT_EQ(v.size(), 9999u);
+        EXPECT_GE(v.capacity(), 9999u);
+    }
+
+    // Reopening maps the same elements back
+    MappedVector<uint32_t> v(dir.path / "v.bin");
+    ASSERT_EQ(v.size(), 9999u);
+    EXPECT_EQ(v[1234], 1234u);
+    EXPECT_EQ(v.back(), 9998u);
+
+    EXPECT_THROW(MappedVector<uint64_t>(dir.path / "v.bin"), std::runtime_error);
+}
+
+TEST(MappedStorageTest, VectorRejectsFileShorterThanItsSize)
+{
+    TempDir dir("mapped_short");
+    std::filesystem::create_directories(dir.path);
+
+    {
+        MappedVector<uint32_t> v(dir.path / "v.bin");
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            v.push_back(i);
+        }
+    }
+
+    // The header still records 5 elements, but only room for 2 is left after it
+    std::filesystem::resize_file(dir.path / "v.bin", 64 + 2 * sizeof(uint32_t));
+    EXPECT_THROW(MappedVector<uint32_t>(dir.path / "v.bin"), std::runtime_error);
+}
+
+TEST(MappedStorageTest, PoolReopensWithoutReload)
+{
+    TempDir dir("mapped_pool");
+    std::vector<Entity> saved;
+
+    {
+        EntityManager em;
+        MappedPool pool(em, MappedStorage(dir.path));
+        for (int i = 0; i < 5000; ++i)
+        {
+            saved.push_back(em.create());
+            pool.emplace(saved.back(), Mass{static_cast<float>(i)});
+        }
+        for (int i = 0; i < 5000; i += 3)
+        {
+            pool.remove(saved[i]);
+            em.destroy(saved[i]);
+        }
+    }
+
+    EntityManager em;
+    MappedPool pool(em, MappedStorage(dir.path));
+    em.restore(pool.entities());
+
+    EXPECT_EQ(pool.size(), 5000u - 1667u);
+    EXPECT_EQ(em.alive_count(), pool.size());
+    for (int i = 0; i < 5000; ++i)
+    {
+        if (i % 3 == 0)
+            EXPECT_FALSE(pool.has(saved[i]));
+        else
+            EXPECT_EQ(pool.get(saved[i]).kg, static_cast<float>(i));
+    }
+
+    // A restored world keeps working: freed slots recycle, views mix storage kinds
+    ComponentPool<int> tags(em);
+    auto e = em.create();
+    pool.emplace(e, Mass{-1.0f});
+    tags.emplace(e, 1);
+    tags.emplace(saved[1], 2);
+
+    float total = 0.0f;
+    View<MappedPool, ComponentPool<int>>(pool, tags).each([&](Entity, Mass& m, int&)
+                                                          { total += m.kg; });
+    EXPECT_FLOAT_EQ(total, 0.0f);
+}
+
+TEST(MappedStorageTest, RestoreRejectsConflictingGenerations)
+{
+    EntityManager em;
+    std::vector<Entity> handles{Entity{3, 1}, Entity{3, 2}};
+    EXPECT_THROW(em.restore(handles), std::invalid_argument);
+
+    em.restore(std::vector<Entity>{Entity{3, 1}});
+    EXPECT_EQ(em.create().index, 0u);
+    EXPECT_THROW(em.restore(handles), std::logic_error);
+}
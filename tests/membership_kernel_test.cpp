@@ -0,0 +1,71 @@
+#include "membership_kernel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using acorn::detail::kMembershipAbsent;
+using acorn::detail::kMembershipBlock;
+
+void expect_matches_scalar(acorn::detail::MembershipKernel kernel)
+{
+    std::vector<uint32_t> sparse(100, kMembershipAbsent);
+    for (uint32_t i = 0; i < sparse.size(); i += 3)
+    {
+        sparse[i] = i * 10;
+    }
+
+    // In range hits and misses, the last slot, just past the end and far past it
+    const std::array<uint32_t, kMembershipBlock> indices = {
+        0, 1, 2, 3, 99, 100, 101, 4, 96, 97, 6, 50, 51, 9, UINT32_MAX - 1, 0};
+
+    std::array<uint32_t, kMembershipBlock> want{};
+    std::array<uint32_t, kMembershipBlock> got{};
+    const uint32_t want_mask = acorn::detail::membership_scalar(indices.data(), sparse.data(),
+                                                                sparse.size(), want.data());
+    EXPECT_EQ(kernel(indices.data(), sparse.data(), sparse.size(), got.data()), want_mask);
+    EXPECT_EQ(got, want);
+
+    // An empty sparse array misses everywhere
+    EXPECT_EQ(kernel(indices.data(), sparse.data(), 0, got.data()), 0u);
+}
+}  // namespace
+
+TEST(MembershipKernelTest, ScalarResolvesPositions)
+{
+    const std::vector<uint32_t> sparse = {7, kMembershipAbsent, 3};
+    std::array<uint32_t, kMembershipBlock> indices{};
+    indices[1] = 1;
+    indices[2] = 2;
+    indices[3] = 3;
+
+    std::array<uint32_t, kMembershipBlock> out{};
+    const uint32_t mask = acorn::detail::membership_scalar(indices.data(), sparse.data(),
+                                                           sparse.size(), out.data());
+
+    EXPECT_EQ(out[0], 7u);
+    EXPECT_EQ(out[1], kMembershipAbsent);
+    EXPECT_EQ(out[2], 3u);
+    EXPECT_EQ(out[3], kMembershipAbsent);
+    // Every other lane reads index 0
+    EXPECT_EQ(mask, 0xFFFFu & ~0b1010u);
+}
+
+TEST(MembershipKernelTest, DispatchedKernelMatchesScalar)
+{
+    expect_matches_scalar(acorn::detail::membership_kernel());
+}
+
+#if ACORN_MEMBERSHIP_X86
+TEST(MembershipKernelTest, VectorKernelsMatchScalar)
+{
+    if (__builtin_cpu_supports("avx2"))
+        expect_matches_scalar(acorn::detail::membership_avx2);
+    if (__builtin_cpu_supports("avx512f"))
+        expect_matches_scalar(acorn::detail::membership_avx512);
+}
+#endif
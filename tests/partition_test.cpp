@@ -0,0 +1,202 @@
+#include "partition.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include "world.hpp"
+
+using namespace acorn;
+
+namespace
+{
+struct Tile
+{
+    int x, y;
+};
+
+struct Link
+{
+    Entity target;
+};
+
+Partition& register_all(Partition& p)
+{
+    p.register_component<Tile>("tile");
+    p.register_component<Link>("link", [](Link& l, const EntityRemap& remap)
+                               { l.target = remap(l.target); });
+    return p;
+}
+}  // namespace
+
+TEST(PartitionTest, AssignMovesBetweenCells)
+{
+    World w;
+    Partition p(w);
+    Entity a = w.create_entity();
+    Entity b = w.create_entity();
+
+    p.assign(a, 1);
+    p.assign(b, 1);
+    p.assign(a, 2);
+
+    EXPECT_EQ(p.cell_of(a), 2u);
+    EXPECT_EQ(p.entities(1).size(), 1u);
+    EXPECT_EQ(p.entities(1)[0], b);
+
+    EXPECT_TRUE(p.remove(b));
+    EXPECT_FALSE(p.is_assigned(b));
+    EXPECT_THROW((void)p.cell_of(b), std::out_of_range);
+    EXPECT_TRUE(p.is_active(b));
+}
+
+TEST(PartitionTest, AssignEvictsDeadEntryOfRecycledIndex)
+{
+    World w;
+    Partition p(w);
+    Entity b = w.create_entity();
+    Entity a = w.create_entity();
+    Entity d = w.create_entity();
+    p.assign(b, 1);
+    p.assign(a, 1);
+    p.assign(d, 2);
+
+    // Destroyed without remove(), then its index comes back
+    w.destroy_entity(a);
+    Entity c = w.create_entity();
+    ASSERT_EQ(c.index, a.index);
+    p.assign(c, 2);
+    EXPECT_EQ(p.entities(1).size(), 1u);
+
+    EXPECT_TRUE(p.remove(b));
+    EXPECT_EQ(p.cell_of(c), 2u);
+    EXPECT_TRUE(p.remove(c));
+    ASSERT_EQ(p.entities(2).size(), 1u);
+    EXPECT_EQ(p.entities(2)[0], d);
+    EXPECT_TRUE(p.entities(1).empty());
+}
+
+TEST(PartitionTest, SaveUnloadLoadRemapsHandles)
+{
+    World w;
+    Partition p(w);
+    register_all(p);
+
+    Entity outside = w.create_entity();
+    std::vector<Entity> cell;
+    for (int i = 0; i < 10; ++i)
+    {
+        Entity e = w.create_entity();
+        w.add<Tile>(e, i, -i);
+        p.assign(e, 7);
+        cell.push_back(e);
+    }
+    // One link inside the cell, one to an entity that stays loaded
+    w.add<Link>(cell[3], cell[9]);
+    w.add<Link>(cell[4], outside);
+
+    const auto blob = p.save(7);
+    EXPECT_EQ(p.unload(7), 10u);
+    EXPECT_FALSE(p.is_loaded(7));
+    EXPECT_EQ(w.pool<Tile>().size(), 0u);
+    EXPECT_FALSE(w.has<Tile>(cell[0]));
+
+    auto loaded = p.load(7, blob);
+    ASSERT_EQ(loaded.size(), 10u);
+    EXPECT_EQ(p.entities(7).size(), 10u);
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(w.get<Tile>(loaded[i]).x, i);
+        EXPECT_EQ(p.cell_of(loaded[i]), 7u);
+    }
+    EXPECT_EQ(w.get<Link>(loaded[3]).target, loaded[9]);
+    EXPECT_EQ(w.get<Link>(loaded[4]).target, outside);
+
+    std::vector<std::byte> junk(blob.begin(), blob.begin() + blob.size() / 2);
+    EXPECT_THROW(p.load(8, junk), std::runtime_error);
+}
+
+TEST(PartitionTest, StreamsCellsThroughFiles)
+{
+    const auto path = std::filesystem::temp_directory_path() / "acorn_partition_cell.bin";
+    World w;
+    Partition p(w);
+    register_all(p);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Entity e = w.create_entity();
+        w.add<Tile>(e, i, i);
+        p.assign(e, 3);
+    }
+
+    p.stream_out(3, path);
+    EXPECT_EQ(w.pool<Tile>().size(), 0u);
+
+    p.stream_in(3, path, false);
+    EXPECT_EQ(p.wait(), 1u);
+    EXPECT_EQ(p.pending_streams(), 0u);
+    EXPECT_EQ(w.pool<Tile>().size(), 100u);
+    EXPECT_FALSE(p.is_cell_active(3));
+
+    std::filesystem::remove(path);
+}
+
+TEST(PartitionTest, FailedStreamOutLoadsTheCellBack)
+{
+    const auto path = std::filesystem::temp_directory_path() / "acorn_missing_dir" / "cell.bin";
+    World w;
+    Partition p(w);
+    register_all(p);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        Entity e = w.create_entity();
+        w.add<Tile>(e, i, i);
+        p.assign(e, 2);
+    }
+    p.set_active(2, false);
+
+    p.stream_out(2, path);
+    EXPECT_EQ(w.pool<Tile>().size(), 0u);
+
+    EXPECT_THROW(p.wait(), std::runtime_error);
+    EXPECT_EQ(p.pending_streams(), 0u);
+    ASSERT_EQ(p.entities(2).size(), 10u);
+    EXPECT_FALSE(p.is_cell_active(2));
+
+    int sum = 0;
+    for (const Entity e : p.entities(2))
+    {
+        sum += w.get<Tile>(e).x;
+    }
+    EXPECT_EQ(sum, 45);
+}
+
+TEST(PartitionTest, EachActiveSkipsInactiveCells)
+{
+    World w;
+    Partition p(w);
+    for (int i = 0; i < 30; ++i)
+    {
+        Entity e = w.create_entity();
+        w.add<Tile>(e, i, 0);
+        if (i % 2 == 0)
+            w.add<int>(e, 1);
+        p.assign(e, static_cast<CellId>(i % 3));
+    }
+    p.set_active(1, false);
+
+    int visited = 0;
+    p.each_active<Tile, int>(
+        [&](Entity e, Tile& t, int&)
+        {
+            EXPECT_NE(t.x % 3, 1);
+            EXPECT_TRUE(p.is_active(e));
+            ++visited;
+        });
+    // Even x in cells 0 and 2: 0, 2, 6, 8, 12, 14, 18, 20, 24, 26
+    EXPECT_EQ(visited, 10);
+}
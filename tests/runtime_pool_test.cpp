@@ -0,0 +1,181 @@
+#include "runtime_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "runtime_view.hpp"
+#include "world.hpp"
+
+namespace
+{
+acorn::ComponentLayout health_layout()
+{
+    return {.name = "Health",
+            .size = 8,
+            .alignment = 4,
+            .fields = {{"current", 0, 4}, {"max", 4, 4}}};
+}
+
+float read_float(const std::byte* p, size_t offset)
+{
+    float value;
+    std::memcpy(&value, p + offset, sizeof(value));
+    return value;
+}
+
+void write_float(std::byte* p, size_t offset, float value)
+{
+    std::memcpy(p + offset, &value, sizeof(value));
+}
+}  // namespace
+
+TEST(RuntimePoolTest, RejectsBadLayouts)
+{
+    acorn::EntityManager em;
+    EXPECT_THROW(acorn::RuntimePool(em, 0, {.name = "Empty", .size = 0}), std::invalid_argument);
+    EXPECT_THROW(acorn::RuntimePool(em, 0, {.name = "Odd", .size = 4, .alignment = 3}),
+                 std::invalid_argument);
+    EXPECT_THROW(acorn::RuntimePool(em, 0, {.name = "Spill", .size = 4, .fields = {{"x", 2, 4}}}),
+                 std::invalid_argument);
+}
+
+TEST(RuntimePoolTest, StoresBytesDenselyWithSwapAndPop)
+{
+    acorn::EntityManager em;
+    acorn::RuntimePool pool(em, 0, {.name = "Vec3", .size = 12, .alignment = 16});
+    EXPECT_EQ(pool.stride(), 16u);
+
+    std::vector<acorn::Entity> entities;
+    for (int i = 0; i < 20; ++i)
+    {
+        entities.push_back(em.create());
+        auto bytes = pool.emplace(entities.back());
+        EXPECT_EQ(read_float(bytes.data(), 0), 0.0f);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(bytes.data()) % 16, 0u);
+        write_float(bytes.data(), 0, static_cast<float>(i));
+    }
+
+    EXPECT_EQ(pool.bytes().size(), 20u * 16u);
+    EXPECT_TRUE(pool.remove(entities[3]));
+    EXPECT_FALSE(pool.remove(entities[3]));
+    EXPECT_FALSE(pool.has(entities[3]));
+    EXPECT_THROW((void)pool.get(entities[3]), std::out_of_range);
+
+    // The last component moved into the hole and kept its value
+    EXPECT_EQ(read_float(pool.get(entities[19]).data(), 0), 19.0f);
+    EXPECT_EQ(pool.entities()[3], entities[19]);
+
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.try_get(entities[0]), nullptr);
+}
+
+TEST(RuntimePoolTest, EmplaceCopiesFromItsOwnComponents)
+{
+    acorn::EntityManager em;
+    acorn::RuntimePool pool(em, 0, health_layout());
+
+    // Fill the buffer to capacity so the next insertion has to grow it
+    const acorn::Entity a = em.create();
+    write_float(pool.emplace(a).data(), 0, 7.0f);
+    while (pool.size() < pool.capacity())
+    {
+        pool.emplace(em.create());
+    }
+
+    const acorn::Entity b = em.create();
+    pool.emplace(b, pool.get(a));
+    EXPECT_EQ(read_float(pool.get(b).data(), 0), 7.0f);
+
+    pool.emplace(a, pool.get(a));
+    EXPECT_EQ(read_float(pool.get(a).data(), 0), 7.0f);
+}
+
+TEST(RuntimePoolTest, WorldRegistersAndCleansUpRuntimePools)
+{
+    acorn::World world;
+    const auto health = world.register_component(health_layout());
+    const auto burning = world.register_component({.name = "Burning", .size = 1});
+    EXPECT_EQ(world.runtime_component("Health"), health);
+    EXPECT_THROW(world.register_component(health_layout()), std::invalid_argument);
+    EXPECT_THROW((void)world.runtime_component("Mana"), std::out_of_range);
+    EXPECT_THROW((void)world.runtime_pool(7), std::out_of_range);
+
+    auto a = world.create_entity();
+    auto b = world.create_entity();
+    auto c = world.create_entity();
+    for (auto e : {a, b, c})
+    {
+        write_float(world.runtime_pool(health).emplace(e).data(), 0, 10.0f);
+    }
+    world.runtime_pool(burning).emplace(b);
+
+    // Health without Burning: damage everyone who is not on fire
+    const acorn::RuntimeComponentId include[] = {health};
+    const acorn::RuntimeComponentId exclude[] = {burning};
+    size_t visited = 0;
+    world.runtime_view(include, exclude)
+        .each(
+            [&](acorn::Entity, std::span<std::byte* const> row)
+            {
+                write_float(row[0], 0, read_float(row[0], 0) - 1.0f);
+                visited++;
+            });
+    EXPECT_EQ(visited, 2u);
+    EXPECT_EQ(read_float(world.runtime_pool(health).get(b).data(), 0), 10.0f);
+    EXPECT_EQ(read_float(world.runtime_pool(health).get(c).data(), 0), 9.0f);
+
+    acorn::World copy(world);
+    EXPECT_EQ(read_float(copy.runtime_pool(health).get(a).data(), 0), 9.0f);
+
+    world.destroy_entity(a);
+    const acorn::Entity batch[] = {b};
+    world.destroy_many(batch);
+    EXPECT_EQ(world.runtime_pool(health).size(), 1u);
+    EXPECT_TRUE(world.runtime_pool(burning).empty());
+    EXPECT_EQ(copy.runtime_pool(health).size(), 3u);
+
+    world.clear();
+    EXPECT_TRUE(world.runtime_pool(health).empty());
+}
+
+TEST(RuntimePoolTest, PrefabsCarryRuntimeComponents)
+{
+    acorn::World world;
+    const auto health = world.register_component(health_layout());
+    const auto burning = world.register_component({.name = "Burning", .size = 1});
+
+    const acorn::Entity source = world.create_entity();
+    write_float(world.runtime_pool(health).emplace(source).data(), 4, 50.0f);
+    world.add<int>(source, 1);
+
+    acorn::Prefab prefab = world.make_prefab(source);
+    EXPECT_EQ(prefab.size(), 2u);
+    EXPECT_TRUE(prefab.has_runtime(health));
+    EXPECT_FALSE(prefab.has_runtime(burning));
+
+    const auto copies = world.instantiate(prefab, 3);
+    for (const acorn::Entity e : copies)
+    {
+        EXPECT_EQ(read_float(world.runtime_pool(health).get(e).data(), 4), 50.0f);
+        EXPECT_FALSE(world.runtime_pool(burning).has(e));
+    }
+
+    // A hibernating entity is captured from its parked components
+    world.hibernate(source);
+    EXPECT_TRUE(world.make_prefab(source).has_runtime(health));
+
+    const std::byte wrong_size[3]{};
+    prefab.set_runtime(burning, wrong_size);
+    const uint32_t before = world.entity_manager().alive_count();
+    EXPECT_THROW(world.instantiate(prefab, 2), std::invalid_argument);
+    EXPECT_EQ(world.entity_manager().alive_count(), before);
+
+    acorn::Prefab foreign;
+    foreign.set_runtime(9, wrong_size);
+    EXPECT_THROW(world.instantiate(foreign, 1), std::out_of_range);
+}
@@ -0,0 +1,267 @@
+#include "shared_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "shared_view.hpp"
+#include "world.hpp"
+
+namespace
+{
+struct Position
+{
+    float x = 0.0f;
+};
+
+std::vector<acorn::Entity> sorted(std::vector<acorn::Entity> entities)
+{
+    std::sort(entities.begin(), entities.end(),
+              [](acorn::Entity a, acorn::Entity b) { return a.index < b.index; });
+    return entities;
+}
+}  // namespace
+
+TEST(SharedPoolTest, EqualValuesAreStoredOnce)
+{
+    acorn::EntityManager em;
+    acorn::SharedPool<std::string> pool(em);
+
+    const acorn::Entity a = em.create();
+    const acorn::Entity b = em.create();
+    const acorn::Entity c = em.create();
+    pool.emplace(a, "rock");
+    pool.emplace(b, "rock");
+    pool.emplace(c, "tree");
+
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool.unique_count(), 2u);
+    EXPECT_EQ(&pool.get(a), &pool.get(b));
+    EXPECT_EQ(pool.get(c), "tree");
+    EXPECT_FALSE(pool.has(em.create()));
+}
+
+TEST(SharedPoolTest, ReassigningReleasesTheLastReference)
+{
+    acorn::EntityManager em;
+    acorn::SharedPool<std::string> pool(em);
+
+    const acorn::Entity a = em.create();
+    const acorn::Entity b = em.create();
+    pool.emplace(a, "rock");
+    pool.emplace(b, "tree");
+
+    pool.emplace(b, "rock");
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.unique_count(), 1u);
+    EXPECT_EQ(pool.get(b), "rock");
+
+    // Setting the same value again is a no-op
+    pool.emplace(a, "rock");
+    EXPECT_EQ(pool.size(), 2u);
+
+    EXPECT_TRUE(pool.remove(a));
+    EXPECT_FALSE(pool.remove(a));
+    EXPECT_EQ(pool.unique_count(), 1u);
+    EXPECT_TRUE(pool.remove(b));
+    EXPECT_EQ(pool.unique_count(), 0u);
+    EXPECT_TRUE(pool.empty());
+    EXPECT_THROW((void)pool.get(b), std::out_of_range);
+}
+
+TEST(SharedPoolTest, GroupsFollowSwapRemoval)
+{
+    acorn::EntityManager em;
+    acorn::SharedPool<int> pool(em);
+
+    std::vector<acorn::Entity> entities;
+    for (int i = 0; i < 12; ++i)
+    {
+        entities.push_back(em.create());
+        pool.emplace(entities.back(), i % 3);
+    }
+    pool.remove(entities[0]);
+    pool.remove(entities[4]);
+    pool.emplace(entities[8], 0);
+
+    std::map<int, std::vector<acorn::Entity>> groups;
+    pool.each_group([&](int value, std::span<const acorn::Entity> members)
+                    { groups[value].assign(members.begin(), members.end()); });
+
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(sorted(groups[0]), (std::vector{entities[3], entities[6], entities[8],
+                                              entities[9]}));
+    EXPECT_EQ(sorted(groups[1]), (std::vector{entities[1], entities[7], entities[10]}));
+    EXPECT_EQ(sorted(groups[2]), (std::vector{entities[2], entities[5], entities[11]}));
+    for (const auto& [value, members] : groups)
+    {
+        for (const acorn::Entity e : members)
+        {
+            EXPECT_EQ(pool.get(e), value);
+        }
+    }
+}
+
+TEST(SharedPoolTest, FreedSlotsAreReused)
+{
+    acorn::EntityManager em;
+    acorn::SharedPool<int> pool(em);
+
+    const acorn::Entity a = em.create();
+    const acorn::Entity b = em.create();
+    pool.emplace(a, 1);
+    pool.emplace(b, 2);
+    pool.remove(a);
+    pool.emplace(a, 3);
+
+    int groups = 0;
+    pool.each_group([&](int, std::span<const acorn::Entity>) { ++groups; });
+    EXPECT_EQ(groups, 2);
+    EXPECT_EQ(pool.get(a), 3);
+    EXPECT_EQ(pool.get(b), 2);
+}
+
+TEST(SharedPoolTest, WorldRemovesSharedComponentsWithTheirEntity)
+{
+    acorn::World world;
+    std::vector<acorn::Entity> entities;
+    for (int i = 0; i < 8; ++i)
+    {
+        entities.push_back(world.create_entity());
+        world.shared<std::string>().emplace(entities.back(), i < 4 ? "a" : "b");
+    }
+
+    world.destroy_entity(entities[0]);
+    EXPECT_EQ(world.shared<std::string>().size(), 7u);
+
+    world.destroy_many(std::span(entities).subspan(4));
+    EXPECT_EQ(world.shared<std::string>().size(), 3u);
+    EXPECT_EQ(world.shared<std::string>().unique_count(), 1u);
+
+    world.clear();
+    EXPECT_TRUE(world.shared<std::string>().empty());
+    EXPECT_EQ(world.shared<std::string>().unique_count(), 0u);
+}
+
+TEST(SharedPoolTest, SharedAndPerEntityStorageAreSeparate)
+{
+    acorn::World world;
+    const acorn::Entity e = world.create_entity();
+    world.add<int>(e, 1);
+    world.shared<int>().emplace(e, 2);
+
+    EXPECT_EQ(world.get<int>(e), 1);
+    EXPECT_EQ(world.shared<int>().get(e), 2);
+
+    const acorn::World& cworld = world;
+    EXPECT_THROW((void)cworld.shared<float>(), std::runtime_error);
+}
+
+TEST(SharedPoolTest, PrefabsShareOneValue)
+{
+    acorn::World world;
+    acorn::Prefab prefab;
+    prefab.set(Position{1.0f}).share(std::string("mesh"));
+    EXPECT_TRUE(prefab.has<acorn::Shared<std::string>>());
+    EXPECT_FALSE(prefab.has<std::string>());
+
+    const auto entities = world.instantiate(prefab, 5);
+    EXPECT_EQ(world.shared<std::string>().size(), 5u);
+    EXPECT_EQ(world.shared<std::string>().unique_count(), 1u);
+
+    const acorn::Prefab captured = world.make_prefab(entities[2]);
+    EXPECT_TRUE(captured.has<acorn::Shared<std::string>>());
+    EXPECT_TRUE(captured.has<Position>());
+
+    const auto more = world.instantiate(captured, 3);
+    EXPECT_EQ(world.shared<std::string>().size(), 8u);
+    EXPECT_EQ(world.shared<std::string>().unique_count(), 1u);
+    EXPECT_EQ(world.shared<std::string>().get(more[0]), "mesh");
+}
+
+TEST(SharedPoolTest, ViewVisitsEachValueOnceWithItsJoinedEntities)
+{
+    acorn::World world;
+    std::vector<acorn::Entity> entities;
+    for (int i = 0; i < 9; ++i)
+    {
+        const acorn::Entity e = world.create_entity();
+        entities.push_back(e);
+        world.shared<std::string>().emplace(e, i % 3 == 0 ? "rock" : "tree");
+        if (i != 4)
+            world.add<Position>(e, Position{static_cast<float>(i)});
+    }
+
+    std::map<std::string, std::vector<acorn::Entity>> visited;
+    std::map<std::string, size_t> sizes;
+    auto view = world.view_shared<std::string, Position>();
+    const uint64_t version = world.pool<Position>().version();
+    view.each_group(
+        [&](const std::string& mesh, auto& group)
+        {
+            EXPECT_EQ(visited.count(mesh), 0u);
+            sizes[mesh] = group.size();
+            group.each(
+                [&](acorn::Entity e, Position& p)
+                {
+                    EXPECT_EQ(p.x, static_cast<float>(e.index));
+                    p.x += 100.0f;
+                    visited[mesh].push_back(e);
+                });
+        });
+
+    EXPECT_EQ(sizes["rock"], 3u);
+    EXPECT_EQ(sizes["tree"], 6u);
+    EXPECT_EQ(sorted(visited["rock"]), (std::vector{entities[0], entities[3], entities[6]}));
+    EXPECT_EQ(visited["tree"].size(), 5u);
+
+    // One bump for the whole pass, so SnapshotPublisher sees the writes
+    EXPECT_EQ(world.pool<Position>().version(), version + 1);
+    EXPECT_EQ(world.get<Position>(entities[1]).x, 101.0f);
+}
+
+TEST(SharedPoolTest, WorldCopyRebuildsSharedPools)
+{
+    acorn::World world;
+    const acorn::Entity a = world.create_entity();
+    const acorn::Entity b = world.create_entity();
+    world.shared<std::string>().emplace(a, "rock");
+    world.shared<std::string>().emplace(b, "rock");
+
+    acorn::World copy(world);
+    copy.shared<std::string>().emplace(b, "tree");
+
+    EXPECT_EQ(copy.shared<std::string>().get(a), "rock");
+    EXPECT_EQ(copy.shared<std::string>().unique_count(), 2u);
+    EXPECT_EQ(world.shared<std::string>().get(b), "rock");
+    EXPECT_EQ(world.shared<std::string>().unique_count(), 1u);
+
+    copy.destroy_entity(a);
+    EXPECT_TRUE(world.shared<std::string>().has(a));
+}
+
+TEST(SharedPoolTest, ViewSkipsDisabledEntities)
+{
+    acorn::World world;
+    const acorn::Entity a = world.create_entity();
+    const acorn::Entity b = world.create_entity();
+    for (const acorn::Entity e : {a, b})
+    {
+        world.shared<int>().emplace(e, 1);
+        world.add<Position>(e);
+    }
+    world.disable(a);
+
+    std::vector<acorn::Entity> visited;
+    world.view_shared<int, Position>().each_group(
+        [&](int, auto& group)
+        {
+            EXPECT_EQ(group.size(), 2u);
+            group.each([&](acorn::Entity e, Position&) { visited.push_back(e); });
+        });
+    EXPECT_EQ(visited, std::vector{b});
+}
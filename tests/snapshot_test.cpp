@@ -0,0 +1,172 @@
+#include "snapshot.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "world.hpp"
+
+namespace
+{
+struct Position
+{
+    float x = 0, y = 0;
+};
+
+struct Orientation
+{
+    float angle = 0;
+};
+}  // namespace
+
+TEST(SnapshotTest, AcquireIsNullBeforeFirstPublish)
+{
+    acorn::World world;
+    acorn::SnapshotPublisher<Position> publisher(world);
+    EXPECT_EQ(publisher.acquire(), nullptr);
+}
+
+TEST(SnapshotTest, SnapshotKeepsPublishTimeContents)
+{
+    acorn::World world;
+    acorn::SnapshotPublisher<Position, Orientation> publisher(world);
+
+    auto a = world.create_entity();
+    auto b = world.create_entity();
+    world.add<Position>(a, 1.0f, 2.0f);
+    world.add<Orientation>(b, 0.5f);
+
+    auto snapshot = publisher.publish();
+    EXPECT_EQ(snapshot->sequence(), 1u);
+    EXPECT_EQ(publisher.acquire(), snapshot);
+
+    // The world moves on; the snapshot does not
+    world.get<Position>(a).x = 10.0f;
+    world.add<Position>(b, 3.0f, 4.0f);
+    world.destroy_entity(a);
+
+    const auto& positions = snapshot->pool<Position>();
+    ASSERT_EQ(positions.size(), 1u);
+    ASSERT_NE(positions.find(a), nullptr);
+    EXPECT_EQ(positions.find(a)->x, 1.0f);
+    EXPECT_EQ(positions.find(b), nullptr);
+    EXPECT_EQ(snapshot->pool<Orientation>().find(b)->angle, 0.5f);
+
+    auto next = publisher.publish();
+    EXPECT_EQ(next->sequence(), 2u);
+    EXPECT_EQ(next->pool<Position>().find(a), nullptr);
+    EXPECT_EQ(next->pool<Position>().find(b)->y, 4.0f);
+}
+
+TEST(SnapshotTest, UnchangedPoolsAreShared)
+{
+    acorn::World world;
+    acorn::SnapshotPublisher<Position, Orientation> publisher(world);
+
+    auto e = world.create_entity();
+    world.add<Position>(e);
+    world.add<Orientation>(e);
+
+    auto first = publisher.publish();
+    EXPECT_EQ(publisher.copies(), 2u);
+
+    // Read-only access leaves versions alone
+    const acorn::World& reader = world;
+    (void)reader.get<Orientation>(e);
+    reader.view<Orientation>().each([](acorn::Entity, const Orientation&) {});
+
+    world.view<Position>().each([](acorn::Entity, Position& p) { p.x += 1.0f; });
+
+    auto second = publisher.publish();
+    EXPECT_EQ(publisher.copies(), 3u);
+    EXPECT_EQ(&first->pool<Orientation>(), &second->pool<Orientation>());
+    EXPECT_NE(first->pool<Position>().version(), second->pool<Position>().version());
+    EXPECT_EQ(second->pool<Position>().find(e)->x, 1.0f);
+    EXPECT_EQ(first->pool<Position>().find(e)->x, 0.0f);
+}
+
+TEST(SnapshotTest, ReusedViewMarksEveryPass)
+{
+    acorn::World world;
+    acorn::SnapshotPublisher<Position> publisher(world);
+
+    auto e = world.create_entity();
+    world.add<Position>(e);
+
+    // Built once, before the first publish, and written through after each one
+    auto view = world.view<Position>();
+    publisher.publish();
+
+    view.each([](acorn::Entity, Position& p) { p.x = 1.0f; });
+    EXPECT_EQ(publisher.publish()->pool<Position>().find(e)->x, 1.0f);
+
+    for (auto [entity, p] : view)
+    {
+        p.x = 2.0f;
+    }
+    EXPECT_EQ(publisher.publish()->pool<Position>().find(e)->x, 2.0f);
+    EXPECT_EQ(publisher.copies(), 3u);
+}
+
+TEST(SnapshotTest, WritesThroughTryGetArePublished)
+{
+    acorn::World world;
+    acorn::SnapshotPublisher<Position> publisher(world);
+
+    auto e = world.create_entity();
+    world.add<Position>(e);
+    publisher.publish();
+
+    const acorn::World& reader = world;
+    (void)reader.try_get<Position>(e);
+    publisher.publish();
+    EXPECT_EQ(publisher.copies(), 1u);
+
+    world.try_get<Position>(e)->x = 3.0f;
+    EXPECT_EQ(publisher.publish()->pool<Position>().find(e)->x, 3.0f);
+    EXPECT_EQ(publisher.copies(), 2u);
+}
+
+TEST(SnapshotTest, ReadersIterateWhileWriterMutates)
+{
+    acorn::World world;
+    acorn::SnapshotPublisher<Position> publisher(world);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        world.add<Position>(world.create_entity());
+    }
+    publisher.publish();
+
+    // Every position of one tick holds the same value, so a torn read would show up as a mix
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::thread reader(
+        [&]
+        {
+            while (!done.load())
+            {
+                auto snapshot = publisher.acquire();
+                const float first = snapshot->pool<Position>().components()[0].x;
+                snapshot->pool<Position>().each(
+                    [&](acorn::Entity, const Position& p)
+                    {
+                        if (p.x != first)
+                            torn++;
+                    });
+            }
+        });
+
+    for (int tick = 1; tick <= 200; ++tick)
+    {
+        world.view<Position>().each([&](acorn::Entity, Position& p)
+                                    { p.x = static_cast<float>(tick); });
+        publisher.publish();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(publisher.acquire()->pool<Position>().components()[0].x, 200.0f);
+}
@@ -0,0 +1,102 @@
+#include "static_world.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "world.hpp"
+
+namespace
+{
+struct Position
+{
+    float x{}, y{};
+};
+
+struct Velocity
+{
+    float dx{}, dy{};
+};
+
+struct Frozen
+{
+};
+
+using Static = acorn::StaticWorld<Position, Velocity, Frozen>;
+
+// Written once against the shared API and run on both world types
+template <typename WorldType>
+std::vector<float> step(WorldType& world)
+{
+    std::vector<float> xs;
+    for (int i = 0; i < 6; ++i)
+    {
+        auto e = world.create_entity();
+        world.template add<Position>(e, static_cast<float>(i), 0.0f);
+        world.template add<Velocity>(e, 1.0f, 0.0f);
+        if (i % 3 == 0)
+            world.template add<Frozen>(e);
+    }
+
+    world.template view_exclude<Position, Velocity>(acorn::Exclude<Frozen>{})
+        .each([](acorn::Entity, Position& p, const Velocity& v) { p.x += v.dx; });
+    world.template view<Position>().each([&](acorn::Entity, const Position& p)
+                                         { xs.push_back(p.x); });
+    return xs;
+}
+}  // namespace
+
+TEST(StaticWorldTest, BehavesLikeWorld)
+{
+    acorn::World dynamic;
+    Static fixed;
+    EXPECT_EQ(step(fixed), step(dynamic));
+}
+
+TEST(StaticWorldTest, AddGetRemoveRoundtrip)
+{
+    Static world;
+    auto e = world.create_entity();
+
+    EXPECT_FALSE(world.has<Position>(e));
+    EXPECT_EQ(world.try_get<Position>(e), nullptr);
+    EXPECT_THROW((void)world.get<Position>(e), std::out_of_range);
+
+    world.add<Position>(e, 1.0f, 2.0f);
+    EXPECT_EQ(world.get<Position>(e).y, 2.0f);
+
+    const Static& cworld = world;
+    EXPECT_EQ(cworld.try_get<Position>(e)->x, 1.0f);
+
+    EXPECT_TRUE(world.remove<Position>(e));
+    EXPECT_FALSE(world.remove<Position>(e));
+}
+
+TEST(StaticWorldTest, DestroyRemovesFromEveryPool)
+{
+    Static world;
+    auto a = world.create_entity();
+    auto b = world.create_entity();
+    auto c = world.create_entity();
+    for (auto e : {a, b, c})
+    {
+        world.add<Position>(e);
+        world.add<Velocity>(e);
+    }
+    world.add<Frozen>(b);
+
+    EXPECT_TRUE(world.destroy_entity(a));
+    EXPECT_FALSE(world.destroy_entity(a));
+    EXPECT_EQ(world.pool<Position>().size(), 2u);
+
+    const acorn::Entity batch[] = {b, b, a};
+    EXPECT_EQ(world.destroy_many(batch), 1u);
+    EXPECT_TRUE(world.pool<Frozen>().empty());
+    EXPECT_EQ(world.pool<Velocity>().size(), 1u);
+    EXPECT_TRUE(world.has<Velocity>(c));
+
+    world.clear();
+    EXPECT_TRUE(world.pool<Position>().empty());
+    EXPECT_FALSE(world.entity_manager().is_alive(c));
+}
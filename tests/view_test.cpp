@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 #include "world.hpp"
 
 TEST(ViewTest, EmptyViewReturnsNothing)
@@ -96,4 +100,270 @@ TEST(ViewTest, EachIterationProvidesCorrectReferences)
 
     EXPECT_EQ(count, 1);
     EXPECT_EQ(world.get<int>(e1), 50);
-}
\ No newline at end of file
+}
+
+TEST(ViewTest, EachPrefetchedMatchesEach)
+{
+    acorn::World world;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, i);
+        if (i % 3 == 0)
+            world.add<float>(e, static_cast<float>(i));
+    }
+
+    auto view = world.view<int, float>();
+
+    std::vector<acorn::Entity> expected;
+    view.each([&](acorn::Entity e, int&, float&) { expected.push_back(e); });
+
+    // Lookahead 0 is clamped, and distances beyond the lead size only run the tail loop
+    for (size_t lookahead : {size_t{0}, size_t{1}, size_t{7}, size_t{64}, size_t{1000}})
+    {
+        std::vector<acorn::Entity> seen;
+        view.each_prefetched(
+            [&](acorn::Entity e, int& i, float& f)
+            {
+                EXPECT_EQ(static_cast<float>(i), f);
+                seen.push_back(e);
+            },
+            lookahead);
+        EXPECT_EQ(seen, expected);
+    }
+}
+
+TEST(ViewTest, LeadPoolInAnyPositionPairsComponents)
+{
+    acorn::World world;
+    for (int i = 0; i < 50; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, i);
+        world.add<double>(e, i * 2.0);
+        if (i % 5 == 0)
+            world.add<float>(e, static_cast<float>(i));
+    }
+
+    // float is the smallest pool, so it leads from the middle of the list
+    size_t each_count = 0;
+    world.view<int, float, double>().each(
+        [&](acorn::Entity, int& i, float& f, double& d)
+        {
+            EXPECT_EQ(static_cast<float>(i), f);
+            EXPECT_EQ(i * 2.0, d);
+            each_count++;
+        });
+
+    size_t iter_count = 0;
+    for (auto [e, i, f, d] : world.view<int, float, double>())
+    {
+        EXPECT_EQ(world.get<int>(e), i);
+        EXPECT_EQ(static_cast<float>(i), f);
+        EXPECT_EQ(i * 2.0, d);
+        iter_count++;
+    }
+
+    EXPECT_EQ(each_count, 10);
+    EXPECT_EQ(iter_count, 10);
+}
+
+TEST(ViewTest, WorksOverCompactHandlePools)
+{
+    using Traits = acorn::CompactEntityTraits;
+    acorn::BasicEntityManager<Traits> em;
+    acorn::ComponentPool<int, Traits> ints(em);
+    acorn::ComponentPool<float, Traits> floats(em);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto e = em.create();
+        ints.emplace(e, i);
+        if (i % 2 == 0)
+            floats.emplace(e, static_cast<float>(i));
+    }
+
+    int sum = 0;
+    acorn::View view{ints, floats};
+    view.each(
+        [&](acorn::BasicEntity<Traits> e, int& i, float& f)
+        {
+            EXPECT_EQ(static_cast<float>(i), f);
+            EXPECT_EQ(*ints.try_get(e), i);
+            sum += i;
+        });
+    EXPECT_EQ(sum, 0 + 2 + 4 + 6 + 8);
+}
+
+TEST(ViewTest, EachBatchedMatchesEach)
+{
+    acorn::World world;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto e = world.create_entity();
+        if (i % 2 == 0)
+            world.add<int>(e, i);
+        if (i % 3 == 0)
+            world.add<float>(e, static_cast<float>(i));
+        // double only reaches the first entities, so later lead indices are past its sparse end
+        if (i < 300 && i % 5 != 0)
+            world.add<double>(e, i * 2.0);
+    }
+
+    std::vector<acorn::Entity> expected;
+    world.view<int, float, double>().each([&](acorn::Entity e, int&, float&, double&)
+                                          { expected.push_back(e); });
+    ASSERT_FALSE(expected.empty());
+
+    std::vector<acorn::Entity> seen;
+    world.view<int, float, double>().each_batched(
+        [&](acorn::Entity e, int& i, float& f, double& d)
+        {
+            EXPECT_EQ(static_cast<float>(i), f);
+            EXPECT_EQ(i * 2.0, d);
+            seen.push_back(e);
+        });
+    EXPECT_EQ(seen, expected);
+
+    // Fewer lead entities than one block only runs the tail loop
+    acorn::World small;
+    auto e = small.create_entity();
+    small.add<int>(e, 1);
+    small.add<float>(e, 1.0f);
+    size_t count = 0;
+    small.view<int, float>().each_batched([&](acorn::Entity, int&, float&) { count++; });
+    EXPECT_EQ(count, 1);
+}
+
+TEST(ViewTest, EachPresentVisitsMatchesInIndexOrder)
+{
+    acorn::World world;
+    std::vector<acorn::Entity> expected;
+    for (int i = 0; i < 500; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, i);
+        if (i % 7 == 0 || (i > 200 && i < 260))
+        {
+            world.add<float>(e, static_cast<float>(i));
+            expected.push_back(e);
+        }
+    }
+
+    auto view = world.view<int, float>();
+    EXPECT_THROW(view.each_present([](acorn::Entity, int&, float&) {}), std::logic_error);
+
+    world.pool<int>().track_presence();
+    world.pool<float>().track_presence();
+
+    std::vector<acorn::Entity> seen;
+    view.each_present(
+        [&](acorn::Entity e, int& i, float& f)
+        {
+            EXPECT_EQ(static_cast<float>(i), f);
+            seen.push_back(e);
+        });
+    EXPECT_EQ(seen, expected);
+}
+
+TEST(ViewTest, EachSafeToleratesRemovalAndInsertion)
+{
+    acorn::World world;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, i);
+        world.add<float>(e, static_cast<float>(i));
+    }
+
+    std::vector<int> visited;
+    world.view<int, float>().each_safe(
+        [&](acorn::Entity e, int& i, float& f)
+        {
+            EXPECT_EQ(static_cast<float>(i), f);
+            visited.push_back(i);
+
+            if (i % 2 == 0)
+            {
+                world.destroy_entity(e);
+                return;
+            }
+            if (i % 3 == 0)
+                world.remove<float>(e);
+            else
+                world.add<double>(e, i * 2.0);
+
+            // Spawned mid-pass, so never visited
+            auto spawned = world.create_entity();
+            world.add<int>(spawned, -1);
+            world.add<float>(spawned, -1.0f);
+        });
+
+    // Every starting entity exactly once, from the back of the lead pool
+    ASSERT_EQ(visited.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(visited[i], 99 - i);
+    }
+
+    size_t survivors = 0;
+    world.view<int, float>().each(
+        [&](acorn::Entity e, int& i, float&)
+        {
+            if (i == -1)
+                return;
+            EXPECT_TRUE(i % 2 != 0 && i % 3 != 0);
+            EXPECT_EQ(world.get<double>(e), i * 2.0);
+            survivors++;
+        });
+    EXPECT_EQ(survivors, 33u);
+    EXPECT_EQ(world.pool<int>().size(), 50u + 50u);
+}
+
+TEST(ViewTest, EveryIterationSkipsDisabledEntities)
+{
+    acorn::World world;
+    world.pool<int>().track_presence();
+    world.pool<float>().track_presence();
+    std::vector<acorn::Entity> expected;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, i);
+        world.add<float>(e, static_cast<float>(i));
+        if (i % 3 == 0)
+            world.disable(e);
+        else
+            expected.push_back(e);
+    }
+
+    auto view = world.view<int, float>();
+    auto collect = [&](auto each)
+    {
+        std::vector<acorn::Entity> seen;
+        each([&](acorn::Entity e, int&, float&) { seen.push_back(e); });
+        std::sort(seen.begin(), seen.end(),
+                  [](acorn::Entity a, acorn::Entity b) { return a.index < b.index; });
+        return seen;
+    };
+
+    EXPECT_EQ(collect([&](auto f) { view.each(f); }), expected);
+    EXPECT_EQ(collect([&](auto f) { view.each_safe(f); }), expected);
+    EXPECT_EQ(collect([&](auto f) { view.each_prefetched(f); }), expected);
+    EXPECT_EQ(collect([&](auto f) { view.each_batched(f); }), expected);
+    EXPECT_EQ(collect([&](auto f) { view.each_present(f); }), expected);
+    EXPECT_EQ(collect(
+                  [&](auto f)
+                  {
+                      for (auto [e, i, x] : view)
+                          f(e, i, x);
+                  }),
+              expected);
+
+    // Components stayed where they were and show up again once enabled
+    EXPECT_EQ(world.get<int>(acorn::Entity{0, 0}), 0);
+    EXPECT_TRUE(world.enable(acorn::Entity{0, 0}));
+    size_t count = 0;
+    view.each([&](acorn::Entity, int&, float&) { count++; });
+    EXPECT_EQ(count, expected.size() + 1);
+}
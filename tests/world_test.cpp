@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -278,4 +279,332 @@ TEST(WorldTest, ClearResetsEverything)
     // Verifying EntityManager reset (new entity should get index 0)
     auto e2 = world.create_entity();
     EXPECT_EQ(e2.index, 0);
-}
\ No newline at end of file
+}
+
+TEST(WorldTest, ClearKeepsOldHandlesInvalid)
+{
+    acorn::World world;
+    std::vector<acorn::Entity> old;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, i);
+        old.push_back(e);
+    }
+    for (size_t i = 10; i < old.size(); ++i)
+    {
+        world.destroy_entity(old[i]);
+    }
+
+    world.clear();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto e = world.create_entity();
+        world.add<int>(e, -i);
+    }
+    EXPECT_EQ(world.pool<int>().size(), 1000u);
+
+    for (auto e : old)
+    {
+        EXPECT_FALSE(world.has<int>(e));
+        EXPECT_FALSE(world.destroy_entity(e));
+    }
+}
+
+TEST(WorldTest, DestroyManyRemovesComponentsFromEveryPool)
+{
+    World w;
+    std::vector<Entity> all;
+    for (int i = 0; i < 100; ++i)
+    {
+        Entity e = w.create_entity();
+        w.add<CompA>(e, CompA{i});
+        if (i % 2 == 0)
+            w.add<CompB>(e, CompB{static_cast<float>(i)});
+        if (i % 10 == 0)
+            w.add<int>(e, i);
+        all.push_back(e);
+    }
+    w.pool<double>();  // registered but empty
+
+    // A large batch walks the pools, a small one walks the batch; cover both
+    std::vector<Entity> doomed(all.begin(), all.begin() + 70);
+    EXPECT_EQ(w.destroy_many(doomed), 70u);
+
+    EXPECT_EQ(w.pool<CompA>().size(), 30u);
+    EXPECT_EQ(w.pool<CompB>().size(), 15u);
+    EXPECT_EQ(w.pool<int>().size(), 3u);
+
+    std::vector<Entity> few{all[71], all[99]};
+    EXPECT_EQ(w.destroy_many(few), 2u);
+    EXPECT_EQ(w.pool<CompA>().size(), 28u);
+
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        const bool destroyed = i < 70 || i == 71 || i == 99;
+        EXPECT_EQ(w.has<CompA>(all[i]), !destroyed);
+        if (!destroyed)
+        {
+            EXPECT_EQ(w.get<CompA>(all[i]).x, static_cast<int>(i));
+        }
+    }
+}
+
+TEST(WorldTest, DestroyManySkipsDeadAndDuplicateHandles)
+{
+    World w;
+    Entity a = w.create_entity();
+    Entity b = w.create_entity();
+    w.add<int>(a, 1);
+    w.add<int>(b, 2);
+    w.destroy_entity(b);
+
+    std::vector<Entity> batch{a, a, b, Entity::null()};
+    EXPECT_EQ(w.destroy_many(batch), 1u);
+    EXPECT_EQ(w.pool<int>().size(), 0u);
+
+    // Scratch state must not leak into the next batch
+    Entity c = w.create_entity();
+    w.add<int>(c, 3);
+    EXPECT_EQ(w.destroy_many(std::vector<Entity>{}), 0u);
+    EXPECT_TRUE(w.has<int>(c));
+}
+
+TEST(WorldTest, InstantiateStampsPrefabComponents)
+{
+    World w;
+    Entity source = w.create_entity();
+    w.add<CompA>(source, CompA{4});
+    w.add<CompB>(source, CompB{2.5f});
+    w.pool<int>();  // registered, but not on the source
+
+    Prefab prefab = w.make_prefab(source);
+    EXPECT_EQ(prefab.size(), 2u);
+    EXPECT_TRUE(prefab.has<CompA>());
+    EXPECT_FALSE(prefab.has<int>());
+
+    prefab.set<CompA>(CompA{9}).set<int>(3);
+    auto copies = w.instantiate(prefab, 50);
+
+    ASSERT_EQ(copies.size(), 50u);
+    EXPECT_EQ(w.pool<CompA>().size(), 51u);
+    for (Entity e : copies)
+    {
+        EXPECT_EQ(w.get<CompA>(e).x, 9);
+        EXPECT_EQ(w.get<CompB>(e).y, 2.5f);
+        EXPECT_EQ(w.get<int>(e), 3);
+    }
+    EXPECT_EQ(w.get<CompA>(source).x, 4);
+
+    w.destroy_entity(source);
+    EXPECT_THROW((void)w.make_prefab(source), std::out_of_range);
+}
+
+TEST(WorldTest, CopyIsIndependentOfOriginal)
+{
+    World w;
+    Entity a = w.create_entity();
+    Entity b = w.create_entity();
+    w.add<CompA>(a, CompA{1});
+    w.add<CompA>(b, CompA{2});
+    w.add<CompB>(b, CompB{3.0f});
+
+    World sandbox(w);
+    EXPECT_EQ(sandbox.get<CompA>(a).x, 1);
+    EXPECT_EQ(sandbox.get<CompB>(b).y, 3.0f);
+
+    sandbox.get<CompA>(a).x = 100;
+    sandbox.destroy_entity(b);
+    Entity c = sandbox.create_entity();
+    sandbox.add<CompB>(c, CompB{7.0f});
+
+    EXPECT_EQ(w.get<CompA>(a).x, 1);
+    EXPECT_TRUE(w.has<CompB>(b));
+    EXPECT_EQ(w.pool<CompB>().size(), 1u);
+    EXPECT_EQ(sandbox.pool<CompB>().size(), 1u);
+    EXPECT_FALSE(sandbox.has<CompA>(b));
+}
+
+namespace
+{
+struct FrameTime
+{
+    float dt;
+};
+
+struct InputState
+{
+    bool jump = false;
+};
+}  // namespace
+
+TEST(WorldTest, ResourcesHoldOneInstancePerType)
+{
+    World w;
+    EXPECT_FALSE(w.has_resource<FrameTime>());
+    EXPECT_EQ(w.try_resource<FrameTime>(), nullptr);
+    EXPECT_THROW((void)w.resource<FrameTime>(), std::out_of_range);
+
+    w.set_resource<FrameTime>(FrameTime{0.016f});
+    w.set_resource<InputState>();
+    EXPECT_FLOAT_EQ(w.resource<FrameTime>().dt, 0.016f);
+
+    // Replacing keeps one instance
+    w.set_resource<FrameTime>(FrameTime{0.5f});
+    auto [time, input] = w.resources<FrameTime, InputState>();
+    EXPECT_FLOAT_EQ(time.dt, 0.5f);
+    input.jump = true;
+    EXPECT_TRUE(w.resource<InputState>().jump);
+
+    // Untouched by entity resets, copied with the world
+    w.clear();
+    World copy(w);
+    copy.resource<FrameTime>().dt = 1.0f;
+    EXPECT_FLOAT_EQ(w.resource<FrameTime>().dt, 0.5f);
+    EXPECT_TRUE(copy.resource<InputState>().jump);
+
+    EXPECT_TRUE(w.remove_resource<InputState>());
+    EXPECT_FALSE(w.remove_resource<InputState>());
+    EXPECT_FALSE(w.has_resource<InputState>());
+}
+
+TEST(WorldTest, HibernateParksComponentsUntilWake)
+{
+    World w;
+    Entity a = w.create_entity();
+    Entity b = w.create_entity();
+    w.add<CompA>(a, CompA{1});
+    w.add<CompB>(a, CompB{2.0f});
+    w.add<CompA>(b, CompA{3});
+    w.shared<int>().emplace(a, 7);
+
+    EXPECT_TRUE(w.hibernate(a));
+    EXPECT_FALSE(w.hibernate(a));
+    EXPECT_TRUE(w.is_hibernating(a));
+    EXPECT_TRUE(w.entity_manager().is_alive(a));
+    EXPECT_FALSE(w.has<CompA>(a));
+    EXPECT_FALSE(w.shared<int>().has(a));
+    EXPECT_EQ(w.pool<CompA>().size(), 1u);
+    EXPECT_TRUE(w.pool<CompB>().empty());
+
+    int visited = 0;
+    w.view<CompA>().each([&](Entity e, CompA&) { EXPECT_EQ(e, b); ++visited; });
+    EXPECT_EQ(visited, 1);
+
+    EXPECT_TRUE(w.wake(a));
+    EXPECT_FALSE(w.wake(a));
+    EXPECT_FALSE(w.is_hibernating(a));
+    EXPECT_EQ(w.get<CompA>(a).x, 1);
+    EXPECT_EQ(w.get<CompB>(a).y, 2.0f);
+    EXPECT_EQ(w.shared<int>().get(a), 7);
+}
+
+TEST(WorldTest, RemoveAndMakePrefabReachParkedComponents)
+{
+    World w;
+    Entity a = w.create_entity();
+    w.add<CompA>(a, CompA{1});
+    w.add<CompB>(a, CompB{2.0f});
+    w.shared<int>().emplace(a, 7);
+    w.hibernate(a);
+
+    const Prefab prefab = w.make_prefab(a);
+    EXPECT_EQ(prefab.size(), 3u);
+    EXPECT_TRUE(prefab.has<Shared<int>>());
+
+    EXPECT_TRUE(w.remove<CompB>(a));
+    EXPECT_FALSE(w.remove<CompB>(a));
+    w.wake(a);
+    EXPECT_FALSE(w.has<CompB>(a));
+    EXPECT_EQ(w.get<CompA>(a).x, 1);
+
+    const Entity copy = w.instantiate(prefab, 1).front();
+    EXPECT_EQ(w.get<CompB>(copy).y, 2.0f);
+    EXPECT_EQ(w.shared<int>().get(copy), 7);
+}
+
+TEST(WorldTest, HibernateManyAndWakeManyMoveBatches)
+{
+    World w;
+    const auto health = w.register_component({.name = "Health", .size = 4, .alignment = 4});
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        Entity e = w.create_entity();
+        w.add<CompA>(e, CompA{i});
+        w.runtime_pool(health).emplace(e)[0] = std::byte(i);
+        entities.push_back(e);
+    }
+
+    std::vector<Entity> sleepers(entities.begin(), entities.begin() + 6);
+    sleepers.push_back(entities[0]);
+    EXPECT_EQ(w.hibernate_many(sleepers), 6u);
+    EXPECT_EQ(w.pool<CompA>().size(), 4u);
+    EXPECT_EQ(w.runtime_pool(health).size(), 4u);
+
+    // Destroying a sleeper drops its parked components
+    w.destroy_entity(entities[1]);
+    EXPECT_EQ(w.wake_many(entities), 5u);
+    EXPECT_EQ(w.pool<CompA>().size(), 9u);
+    for (int i = 0; i < 10; ++i)
+    {
+        if (i == 1)
+            continue;
+        EXPECT_EQ(w.get<CompA>(entities[i]).x, i);
+        EXPECT_EQ(w.runtime_pool(health).get(entities[i])[0], std::byte(i));
+    }
+
+    // Reused slots do not inherit the hibernating state
+    Entity reused = w.create_entity();
+    EXPECT_FALSE(w.is_hibernating(reused));
+}
+
+TEST(WorldTest, HibernatingEntitiesSurviveCopyAndDieWithClear)
+{
+    World w;
+    Entity a = w.create_entity();
+    w.add<CompA>(a, CompA{5});
+    w.hibernate(a);
+
+    World copy(w);
+    EXPECT_TRUE(copy.is_hibernating(a));
+    EXPECT_TRUE(copy.wake(a));
+    EXPECT_EQ(copy.get<CompA>(a).x, 5);
+    EXPECT_TRUE(w.is_hibernating(a));
+
+    w.destroy_many(std::span(&a, 1));
+    EXPECT_FALSE(w.is_hibernating(a));
+
+    Entity b = w.create_entity();
+    w.add<CompA>(b, CompA{6});
+    w.hibernate(b);
+    w.clear();
+    Entity c = w.create_entity();
+    EXPECT_FALSE(w.is_hibernating(c));
+    EXPECT_FALSE(w.wake(c));
+    EXPECT_FALSE(w.has<CompA>(c));
+}
+
+TEST(WorldTest, MoveKeepsPoolsBoundAndSupportsMoveOnlyComponents)
+{
+    World w;
+    Entity a = w.create_entity();
+    w.add<CompA>(a, CompA{4});
+    w.add<std::unique_ptr<int>>(a, std::make_unique<int>(9));
+    const CompA* stored = &w.get<CompA>(a);
+
+    World moved(std::move(w));
+    EXPECT_EQ(&moved.get<CompA>(a), stored);
+    EXPECT_EQ(*moved.get<std::unique_ptr<int>>(a), 9);
+
+    // Pools still answer through the moved entity manager
+    Entity b = moved.create_entity();
+    moved.add<CompA>(b, CompA{5});
+    EXPECT_TRUE(moved.destroy_entity(a));
+    EXPECT_FALSE(moved.has<CompA>(a));
+
+    World assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.get<CompA>(b).x, 5);
+}